@@ -0,0 +1,534 @@
+#include <EventCore/EventDispatcher.hpp>
+#include <EventCore/StaticEventDispatcher.hpp>
+#include <EventCore/EventReplayer.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Benchmark event types
+struct TickEvent : public EventCore::Event {
+    std::uint64_t frame;
+
+    explicit TickEvent(std::uint64_t f) : frame(f) {}
+};
+
+struct EntityEvent : public EventCore::Event {
+    std::uint64_t entity;
+
+    explicit EntityEvent(std::uint64_t e) : entity(e) {}
+    std::uint64_t event_key() const { return entity; }
+};
+
+struct InputEvent : public EventCore::Event {
+    int key;
+
+    explicit InputEvent(int k) : key(k) {}
+};
+
+struct SampleEvent : public EventCore::Event {
+    static constexpr bool event_recordable = true;
+    std::uint64_t frame = 0;
+    float value = 0.0f;
+};
+
+// Listeners do a little observable work so calls cannot be optimized away
+class CountingListener {
+public:
+    void on_tick(const TickEvent& event) {
+        sum_ += event.frame;
+        benchmark::DoNotOptimize(sum_);
+    }
+
+    std::uint64_t sum() const { return sum_; }
+
+private:
+    std::uint64_t sum_ = 0;
+};
+
+class ConcurrentListener {
+public:
+    void on_tick(const TickEvent& event) {
+        count_.fetch_add(event.frame, std::memory_order_relaxed);
+    }
+
+    std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> count_{0};
+};
+
+class InputListener {
+public:
+    explicit InputListener(bool consumes) : consumes_(consumes) {}
+
+    EventCore::EventResult on_input(const InputEvent& event) {
+        benchmark::DoNotOptimize(event.key);
+        return consumes_ ? EventCore::EventResult::Consumed : EventCore::EventResult::Continue;
+    }
+
+private:
+    bool consumes_;
+};
+
+constexpr EventCore::EventPriority kPriorities[] = {
+    EventCore::EventPriority::Low,
+    EventCore::EventPriority::Normal,
+    EventCore::EventPriority::High,
+    EventCore::EventPriority::Critical
+};
+
+// ============================================================================
+// Immediate dispatch vs. listener count
+// ============================================================================
+
+// Owned listeners: one weak_ptr lock per call
+static void BM_Dispatch_Owned(benchmark::State& state) {
+    EventCore::EventDispatcher dispatcher;
+    std::vector<std::shared_ptr<CountingListener>> listeners;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        listeners.push_back(std::make_shared<CountingListener>());
+        dispatcher.subscribe<TickEvent>(listeners.back(), &CountingListener::on_tick);
+    }
+
+    std::uint64_t frame = 0;
+    for (auto _ : state) {
+        dispatcher.dispatch(TickEvent{++frame});
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Dispatch_Owned)->RangeMultiplier(4)->Range(1, 1024);
+
+// Unowned listeners: one indirect call per listener
+static void BM_Dispatch_Unowned(benchmark::State& state) {
+    EventCore::EventDispatcher dispatcher;
+    std::vector<CountingListener> listeners(static_cast<std::size_t>(state.range(0)));
+    for (auto& listener : listeners) {
+        dispatcher.subscribe_unowned<TickEvent>(&listener, &CountingListener::on_tick);
+    }
+
+    std::uint64_t frame = 0;
+    for (auto _ : state) {
+        dispatcher.dispatch(TickEvent{++frame});
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Dispatch_Unowned)->RangeMultiplier(4)->Range(1, 1024);
+
+// Compile-time bound handlers on the closed-set dispatcher
+static void BM_Dispatch_Static(benchmark::State& state) {
+    EventCore::StaticEventDispatcher<TickEvent, InputEvent> dispatcher;
+    std::vector<CountingListener> listeners(static_cast<std::size_t>(state.range(0)));
+    for (auto& listener : listeners) {
+        dispatcher.subscribe_unowned<&CountingListener::on_tick>(&listener);
+    }
+
+    std::uint64_t frame = 0;
+    for (auto _ : state) {
+        dispatcher.dispatch(TickEvent{++frame});
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Dispatch_Static)->RangeMultiplier(4)->Range(1, 1024);
+
+// 64 events to range(0) listeners; range(1) = 1 as one dispatch_batch, 0 as 64 dispatch calls.
+// Items are events in both arms, so the two rows of a listener count compare directly
+static void BM_DispatchBatch(benchmark::State& state) {
+    EventCore::EventDispatcher dispatcher;
+    std::vector<CountingListener> listeners(static_cast<std::size_t>(state.range(0)));
+    for (auto& listener : listeners) {
+        dispatcher.subscribe_unowned<TickEvent>(&listener, &CountingListener::on_tick);
+    }
+
+    std::vector<TickEvent> events;
+    for (std::uint64_t i = 0; i < 64; ++i) {
+        events.emplace_back(i);
+    }
+
+    const bool batched = state.range(1) != 0;
+    for (auto _ : state) {
+        if (batched) {
+            dispatcher.dispatch_batch<TickEvent>(events);
+        } else {
+            for (const TickEvent& event : events) {
+                dispatcher.dispatch(event);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+BENCHMARK(BM_DispatchBatch)->ArgsProduct({{1, 16, 256}, {0, 1}});
+
+// ============================================================================
+// Priority mixes
+// ============================================================================
+
+// range(0) listeners spread round-robin over the four priority bands
+static void BM_Dispatch_PriorityMix(benchmark::State& state) {
+    EventCore::EventDispatcher dispatcher;
+    std::vector<CountingListener> listeners(static_cast<std::size_t>(state.range(0)));
+    for (std::size_t i = 0; i < listeners.size(); ++i) {
+        dispatcher.subscribe_unowned<TickEvent>(&listeners[i], &CountingListener::on_tick, kPriorities[i % 4]);
+    }
+
+    std::uint64_t frame = 0;
+    for (auto _ : state) {
+        dispatcher.dispatch(TickEvent{++frame});
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Dispatch_PriorityMix)->RangeMultiplier(4)->Range(4, 1024);
+
+// A Critical handler consumes the event; range(1) = 1 consumes, 0 continues
+static void BM_Dispatch_ConsumedChain(benchmark::State& state) {
+    EventCore::EventDispatcher dispatcher;
+    InputListener capture(state.range(1) != 0);
+    dispatcher.subscribe_unowned<InputEvent>(&capture, &InputListener::on_input,
+                                             EventCore::EventPriority::Critical);
+
+    std::vector<InputListener> listeners(static_cast<std::size_t>(state.range(0)), InputListener(false));
+    for (std::size_t i = 0; i < listeners.size(); ++i) {
+        dispatcher.subscribe_unowned<InputEvent>(&listeners[i], &InputListener::on_input, kPriorities[i % 3]);
+    }
+
+    int key = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dispatcher.dispatch(InputEvent{++key}));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Dispatch_ConsumedChain)->ArgsProduct({{16, 256}, {0, 1}});
+
+// ============================================================================
+// Keyed routing
+// ============================================================================
+
+// range(0) entities each listening for their own events; range(1) = 1
+// subscribes by key, 0 subscribes to the whole type and filters in the handler
+static void BM_Dispatch_PerEntity(benchmark::State& state) {
+    EventCore::EventDispatcher dispatcher;
+    const auto entityCount = static_cast<std::uint64_t>(state.range(0));
+    std::uint64_t hits = 0;
+    for (std::uint64_t entity = 0; entity < entityCount; ++entity) {
+        if (state.range(1) != 0) {
+            dispatcher.subscribe<EntityEvent>(entity, [&hits](const EntityEvent&) { ++hits; });
+        } else {
+            dispatcher.subscribe<EntityEvent>([&hits, entity](const EntityEvent& event) {
+                if (event.entity == entity) {
+                    ++hits;
+                }
+            });
+        }
+    }
+
+    std::uint64_t next = 0;
+    for (auto _ : state) {
+        dispatcher.dispatch(EntityEvent{next});
+        next = next + 1 == entityCount ? 0 : next + 1;
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Dispatch_PerEntity)->ArgsProduct({{16, 5000}, {0, 1}});
+
+// ============================================================================
+// Enqueue/drain throughput vs. producer count
+// ============================================================================
+
+// range(0) producer threads enqueue while the benchmark thread drains
+static void BM_EnqueueDrain(benchmark::State& state) {
+    constexpr std::size_t kEventsPerProducer = 16384;
+    const auto producerCount = static_cast<std::size_t>(state.range(0));
+
+    EventCore::EventDispatcher dispatcher;
+    ConcurrentListener listener;
+    dispatcher.subscribe_unowned<TickEvent>(&listener, &ConcurrentListener::on_tick);
+    EventCore::EventDispatcher::Consumer consumer(dispatcher);
+
+    for (auto _ : state) {
+        std::vector<std::thread> producers;
+        for (std::size_t p = 0; p < producerCount; ++p) {
+            producers.emplace_back([&dispatcher] {
+                EventCore::EventDispatcher::Producer producer(dispatcher);
+                for (std::size_t i = 0; i < kEventsPerProducer; ++i) {
+                    producer.enqueue(TickEvent{1});
+                }
+            });
+        }
+
+        const std::size_t expected = producerCount * kEventsPerProducer;
+        std::size_t processed = 0;
+        while (processed < expected) {
+            processed += dispatcher.process_queued_events(consumer);
+        }
+
+        for (auto& producer : producers) {
+            producer.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(producerCount * kEventsPerProducer));
+}
+BENCHMARK(BM_EnqueueDrain)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Enqueue then drain on one thread, 256 events at a time
+static void BM_EnqueueDrain_SingleThread(benchmark::State& state) {
+    constexpr std::size_t kBatch = 256;
+
+    EventCore::EventDispatcher dispatcher;
+    CountingListener listener;
+    dispatcher.subscribe_unowned<TickEvent>(&listener, &CountingListener::on_tick);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < kBatch; ++i) {
+            dispatcher.enqueue(TickEvent{i});
+        }
+        dispatcher.process_queued_events();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kBatch));
+}
+BENCHMARK(BM_EnqueueDrain_SingleThread);
+
+// Enqueue-to-dispatch latency of a consumer blocked in wait_and_process():
+// range(0) 0 parks immediately, 1 spins and yields first (default WaitStrategy)
+static void BM_WaitAndProcess_Wakeup(benchmark::State& state) {
+    EventCore::DispatcherConfig config;
+    if (state.range(0) == 0) {
+        config.wait = EventCore::WaitStrategy::park_immediately();
+    }
+
+    EventCore::EventDispatcher dispatcher(config);
+    ConcurrentListener listener;
+    dispatcher.subscribe_unowned<TickEvent>(&listener, &ConcurrentListener::on_tick);
+
+    std::atomic<bool> running{true};
+    std::thread consumer([&] {
+        while (running.load(std::memory_order_relaxed)) {
+            dispatcher.wait_and_process(std::chrono::seconds(1));
+        }
+    });
+
+    std::uint64_t expected = 0;
+    for (auto _ : state) {
+        dispatcher.enqueue(TickEvent{1});
+        ++expected;
+        while (listener.count() != expected) {
+            std::this_thread::yield();
+        }
+    }
+
+    running.store(false, std::memory_order_relaxed);
+    dispatcher.wake_waiting_consumers();
+    consumer.join();
+}
+BENCHMARK(BM_WaitAndProcess_Wakeup)->Arg(0)->Arg(1)->UseRealTime();
+
+// Schedule and fire 256 due events while range(0) far-future timers stay pending
+static void BM_ScheduleFire(benchmark::State& state) {
+    constexpr std::size_t kBatch = 256;
+
+    EventCore::EventDispatcher dispatcher;
+    CountingListener listener;
+    dispatcher.subscribe_unowned<TickEvent>(&listener, &CountingListener::on_tick);
+
+    const auto now = std::chrono::steady_clock::now();
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        dispatcher.enqueue_at(now + std::chrono::hours(1) + std::chrono::milliseconds(i), TickEvent{0});
+    }
+
+    for (auto _ : state) {
+        const auto due = std::chrono::steady_clock::now() - std::chrono::milliseconds(1);
+        for (std::size_t i = 0; i < kBatch; ++i) {
+            dispatcher.enqueue_at(due, TickEvent{i});
+        }
+        dispatcher.process_queued_events();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kBatch));
+}
+BENCHMARK(BM_ScheduleFire)->Arg(0)->Arg(1024)->Arg(65536);
+
+// ============================================================================
+// Subscribe/unsubscribe churn
+// ============================================================================
+
+// Subscribe and remove by handle next to range(0) resident listeners
+static void BM_SubscribeUnsubscribe_Handle(benchmark::State& state) {
+    EventCore::EventDispatcher dispatcher;
+    std::vector<CountingListener> resident(static_cast<std::size_t>(state.range(0)));
+    for (auto& listener : resident) {
+        dispatcher.subscribe_unowned<TickEvent>(&listener, &CountingListener::on_tick);
+    }
+
+    CountingListener transient;
+    for (auto _ : state) {
+        auto handle = dispatcher.subscribe_unowned<TickEvent>(&transient, &CountingListener::on_tick);
+        dispatcher.unsubscribe(handle);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SubscribeUnsubscribe_Handle)->RangeMultiplier(8)->Range(1, 4096);
+
+// Same churn, removing by listener pointer and member function (O(n) scan)
+static void BM_SubscribeUnsubscribe_Member(benchmark::State& state) {
+    EventCore::EventDispatcher dispatcher;
+    std::vector<CountingListener> resident(static_cast<std::size_t>(state.range(0)));
+    for (auto& listener : resident) {
+        dispatcher.subscribe_unowned<TickEvent>(&listener, &CountingListener::on_tick);
+    }
+
+    CountingListener transient;
+    for (auto _ : state) {
+        dispatcher.subscribe_unowned<TickEvent>(&transient, &CountingListener::on_tick);
+        dispatcher.unsubscribe<TickEvent>(&transient, &CountingListener::on_tick);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SubscribeUnsubscribe_Member)->RangeMultiplier(8)->Range(1, 4096);
+
+// Dispatch on one thread while another thread churns subscriptions
+static void BM_Dispatch_UnderChurn(benchmark::State& state) {
+    EventCore::EventDispatcher dispatcher;
+    std::vector<CountingListener> resident(64);
+    for (auto& listener : resident) {
+        dispatcher.subscribe_unowned<TickEvent>(&listener, &CountingListener::on_tick);
+    }
+
+    std::atomic<bool> stop{false};
+    std::thread churn([&] {
+        ConcurrentListener transient;
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto handle = dispatcher.subscribe_unowned<TickEvent>(&transient, &ConcurrentListener::on_tick);
+            dispatcher.unsubscribe(handle);
+        }
+    });
+
+    std::uint64_t frame = 0;
+    for (auto _ : state) {
+        dispatcher.dispatch(TickEvent{++frame});
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    churn.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Dispatch_UnderChurn)->UseRealTime();
+
+// ============================================================================
+// Expired-listener cleanup
+// ============================================================================
+
+// cleanup_expired_listeners() after range(0) of 1024 owned listeners expired
+static void BM_CleanupExpired(benchmark::State& state) {
+    constexpr std::int64_t kListenerCount = 1024;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto dispatcher = std::make_unique<EventCore::EventDispatcher>(EventCore::CleanupPolicy::manual());
+        std::vector<std::shared_ptr<CountingListener>> listeners;
+        for (std::int64_t i = 0; i < kListenerCount; ++i) {
+            listeners.push_back(std::make_shared<CountingListener>());
+            dispatcher->subscribe<TickEvent>(listeners.back(), &CountingListener::on_tick);
+        }
+        listeners.resize(static_cast<std::size_t>(kListenerCount - state.range(0)));
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(dispatcher->cleanup_expired_listeners());
+
+        // Tear down outside the timed region
+        state.PauseTiming();
+        dispatcher.reset();
+        listeners.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * kListenerCount);
+}
+BENCHMARK(BM_CleanupExpired)->Arg(16)->Arg(256)->Arg(1024);
+
+// Dispatch cost while half the listeners are expired, per cleanup policy
+static void BM_Dispatch_WithExpired(benchmark::State& state) {
+    const bool amortized = state.range(0) != 0;
+    EventCore::EventDispatcher dispatcher(amortized ? EventCore::CleanupPolicy::amortized()
+                                                    : EventCore::CleanupPolicy::manual());
+    std::vector<std::shared_ptr<CountingListener>> listeners;
+    for (int i = 0; i < 256; ++i) {
+        listeners.push_back(std::make_shared<CountingListener>());
+        dispatcher.subscribe<TickEvent>(listeners.back(), &CountingListener::on_tick);
+    }
+    for (std::size_t i = 0; i < listeners.size(); i += 2) {
+        listeners[i].reset();
+    }
+
+    std::uint64_t frame = 0;
+    for (auto _ : state) {
+        dispatcher.dispatch(TickEvent{++frame});
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Dispatch_WithExpired)->Arg(0)->Arg(1);
+
+// ============================================================================
+// Recording and replay
+// ============================================================================
+
+static std::string recording_path() {
+    return (std::filesystem::temp_directory_path() / "eventcore_bench.ecrl").string();
+}
+
+// Dispatch with and without a recorder attached (range(0) = attached)
+static void BM_Dispatch_Recording(benchmark::State& state) {
+    EventCore::EventDispatcher dispatcher;
+    std::uint64_t sum = 0;
+    dispatcher.subscribe<SampleEvent>([&sum](const SampleEvent& event) { sum += event.frame; });
+
+    EventCore::EventRecorder recorder(recording_path());
+    if (state.range(0) != 0) {
+        dispatcher.attach_recorder(&recorder);
+    }
+
+    SampleEvent event;
+    for (auto _ : state) {
+        ++event.frame;
+        dispatcher.dispatch(event);
+    }
+    benchmark::DoNotOptimize(sum);
+    dispatcher.attach_recorder(nullptr);
+    state.counters["dropped"] = static_cast<double>(recorder.dropped_count());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Dispatch_Recording)->Arg(0)->Arg(1);
+
+// Replay of 65536 recorded dispatches at the maximal rate into 4 listeners
+static void BM_Replay_Maximal(benchmark::State& state) {
+    constexpr std::size_t kRecordCount = 65536;
+    {
+        EventCore::EventRecorder recorder(recording_path());
+        SampleEvent event;
+        for (std::size_t i = 0; i < kRecordCount; ++i) {
+            ++event.frame;
+            recorder.record(event);
+        }
+    }
+
+    EventCore::EventDispatcher dispatcher;
+    std::uint64_t sum = 0;
+    for (int i = 0; i < 4; ++i) {
+        dispatcher.subscribe<SampleEvent>([&sum](const SampleEvent& event) { sum += event.frame; });
+    }
+
+    EventCore::EventReplayer replayer(recording_path());
+    replayer.register_type<SampleEvent>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(replayer.replay(dispatcher).replayed);
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kRecordCount));
+}
+BENCHMARK(BM_Replay_Maximal)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "Event.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+
+namespace EventCore {
+namespace detail {
+
+/**
+ * @brief Type-erased contiguous run of events passed to batch delegates
+ */
+struct EventSpan {
+    const void* data;
+    std::size_t count;
+};
+
+/**
+ * @brief Decomposes an event handler member function pointer type
+ */
+template<typename MemberFuncT>
+struct member_handler_traits;
+
+template<typename ResultT, typename ListenerT, typename EventT>
+struct member_handler_traits<ResultT (ListenerT::*)(const EventT&)> {
+    using listener_type = ListenerT;
+    using event_type = EventT;
+    using result_type = ResultT;
+};
+
+/**
+ * @brief Call a handler and report whether it consumed the event
+ */
+template<typename Fn>
+inline bool invoke_handler(Fn&& fn) {
+    using ResultT = std::invoke_result_t<Fn&>;
+    static_assert(EventHandlerResult<ResultT>, "Event handlers must return void or EventResult");
+
+    if constexpr (std::is_void_v<ResultT>) {
+        fn();
+        return false;
+    } else {
+        return fn() == EventResult::Consumed;
+    }
+}
+
+/**
+ * @brief Fixed-size, non-allocating type-erased event callback
+ *
+ * A Delegate is a trampoline function pointer plus a small inline buffer
+ * holding the bound state (e.g. object pointer + member function pointer).
+ * Invoking it is a single indirect call; copying it is a memcpy. Unlike
+ * std::function it never allocates and has no virtual dispatch. The call
+ * returns true when the handler consumed the event (see EventResult).
+ *
+ * Bound state must be trivially copyable and fit in kStorageSize bytes,
+ * which is enforced at compile time.
+ */
+class Delegate {
+public:
+    using Trampoline = bool (*)(const void* storage, const void* eventData);
+
+    // Object pointer + the largest member function pointer representation (MSVC)
+    static constexpr std::size_t kStorageSize = 4 * sizeof(void*);
+
+    Delegate() = default;
+
+    /**
+     * @brief Bind a member function of a listener instance
+     */
+    template<typename EventT, typename ListenerT, EventHandlerResult ResultT>
+    static Delegate bind_member(ListenerT* instance, ResultT (ListenerT::*memberFunc)(const EventT&)) noexcept {
+        struct BoundMember {
+            ListenerT* instance;
+            ResultT (ListenerT::*memberFunc)(const EventT&);
+        };
+
+        return make<BoundMember>(BoundMember{instance, memberFunc},
+            [](const void* storage, const void* eventData) {
+                const auto* bound = std::launder(static_cast<const BoundMember*>(storage));
+                return invoke_handler([&] {
+                    return (bound->instance->*bound->memberFunc)(*static_cast<const EventT*>(eventData));
+                });
+            });
+    }
+
+    /**
+     * @brief Bind a member function known at compile time
+     * 
+     * Only the instance pointer is stored; the call to MemberFunc is a
+     * constant inside the trampoline, so the compiler can inline the
+     * handler body into it.
+     */
+    template<auto MemberFunc>
+    static Delegate bind_method(typename member_handler_traits<decltype(MemberFunc)>::listener_type* instance) noexcept {
+        using Traits = member_handler_traits<decltype(MemberFunc)>;
+        using ListenerT = typename Traits::listener_type;
+        using EventT = typename Traits::event_type;
+
+        return make<ListenerT*>(instance,
+            [](const void* storage, const void* eventData) {
+                ListenerT* listener = *std::launder(static_cast<ListenerT* const*>(storage));
+                return invoke_handler([&] {
+                    return (listener->*MemberFunc)(*static_cast<const EventT*>(eventData));
+                });
+            });
+    }
+
+    /**
+     * @brief Bind a member function that consumes a span of events
+     * 
+     * The resulting delegate expects a pointer to an EventSpan instead of a
+     * pointer to a single event.
+     */
+    template<typename EventT, typename ListenerT>
+    static Delegate bind_batch_member(ListenerT* instance,
+                                      void (ListenerT::*memberFunc)(std::span<const EventT>)) noexcept {
+        struct BoundBatchMember {
+            ListenerT* instance;
+            void (ListenerT::*memberFunc)(std::span<const EventT>);
+        };
+
+        return make<BoundBatchMember>(BoundBatchMember{instance, memberFunc},
+            [](const void* storage, const void* eventData) {
+                const auto* bound = std::launder(static_cast<const BoundBatchMember*>(storage));
+                const auto* events = static_cast<const EventSpan*>(eventData);
+                (bound->instance->*bound->memberFunc)(
+                    std::span<const EventT>(static_cast<const EventT*>(events->data), events->count));
+                return false;
+            });
+    }
+
+    /**
+     * @brief Bind a lambda, free function or other small callable by value
+     * 
+     * The callable is copied into the inline storage, so it must be
+     * trivially copyable and fit in kStorageSize bytes (captureless lambdas,
+     * function pointers, lambdas capturing a few pointers or integers). It
+     * is invoked as const, because snapshots may hold several copies.
+     */
+    template<typename EventT, typename CallableT>
+    static Delegate bind_callable(CallableT&& callable) noexcept {
+        using StoredT = std::decay_t<CallableT>;
+        static_assert(std::is_invocable_v<const StoredT&, const EventT&>,
+                      "Callable must be invocable as const with const EventT&");
+        static_assert(std::is_trivially_copyable_v<StoredT> && sizeof(StoredT) <= kStorageSize,
+                      "Callable is too large or not trivially copyable to store inline; bind it by reference instead");
+
+        return make<StoredT>(StoredT(std::forward<CallableT>(callable)),
+            [](const void* storage, const void* eventData) {
+                const auto& bound = *std::launder(static_cast<const StoredT*>(storage));
+                return invoke_handler([&] { return bound(*static_cast<const EventT*>(eventData)); });
+            });
+    }
+
+    /**
+     * @brief Bind a callable by reference (function_ref style)
+     * 
+     * Only a pointer is stored; the caller keeps the callable alive for as
+     * long as the delegate can be invoked.
+     */
+    template<typename EventT, typename CallableT>
+    static Delegate bind_callable_ref(CallableT& callable) noexcept {
+        static_assert(std::is_invocable_v<CallableT&, const EventT&>,
+                      "Callable must be invocable with const EventT&");
+
+        return make<CallableT*>(std::addressof(callable),
+            [](const void* storage, const void* eventData) {
+                CallableT* bound = *std::launder(static_cast<CallableT* const*>(storage));
+                return invoke_handler([&] { return (*bound)(*static_cast<const EventT*>(eventData)); });
+            });
+    }
+
+    /**
+     * @brief Invoke the bound callback with a type-erased event pointer
+     *
+     * @return true if the handler consumed the event
+     */
+    bool operator()(const void* eventData) const {
+        return trampoline_(storage_, eventData);
+    }
+
+    explicit operator bool() const noexcept { return trampoline_ != nullptr; }
+
+    /**
+     * @brief Two delegates are equal when they share a trampoline and bound state
+     */
+    bool operator==(const Delegate& other) const noexcept {
+        return trampoline_ == other.trampoline_ &&
+               std::memcmp(storage_, other.storage_, kStorageSize) == 0;
+    }
+
+private:
+    template<typename Payload>
+    static Delegate make(const Payload& payload, Trampoline trampoline) noexcept {
+        static_assert(sizeof(Payload) <= kStorageSize, "Delegate payload exceeds inline storage");
+        static_assert(alignof(Payload) <= alignof(void*), "Delegate payload is over-aligned");
+        static_assert(std::is_trivially_copyable_v<Payload>, "Delegate payload must be trivially copyable");
+
+        Delegate delegate;
+        ::new (static_cast<void*>(delegate.storage_)) Payload(payload);
+        delegate.trampoline_ = trampoline;
+        return delegate;
+    }
+
+    Trampoline trampoline_ = nullptr;
+    alignas(void*) unsigned char storage_[kStorageSize]{};
+};
+
+} // namespace detail
+} // namespace EventCore
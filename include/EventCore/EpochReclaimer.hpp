@@ -0,0 +1,229 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace EventCore {
+namespace detail {
+
+/**
+ * @brief Epoch-based memory reclamation for read-mostly shared data
+ *
+ * Readers enter a critical section by publishing the current global epoch
+ * in a per-thread record; writers retire replaced objects tagged with the
+ * epoch at which they were unlinked. A retired object is freed once every
+ * active reader has announced a newer epoch, so readers never need locks or
+ * reference counts to safely dereference a published pointer.
+ *
+ * A single process-wide domain is shared by all dispatchers. Thread records
+ * are cache-line aligned so that announcing an epoch only touches memory
+ * owned by the calling thread.
+ */
+class EpochDomain {
+public:
+    static constexpr std::uint64_t kIdleEpoch = ~std::uint64_t{0};
+
+    struct alignas(64) ThreadRecord {
+        std::atomic<std::uint64_t> epoch{kIdleEpoch};   // Announced epoch (kIdleEpoch when outside a guard)
+        std::atomic<bool> inUse{false};                 // Owned by a live thread
+        std::uint32_t depth = 0;                        // Guard nesting depth (owner thread only)
+        ThreadRecord* next = nullptr;                   // Intrusive registry list (push-only)
+    };
+
+    EpochDomain() = default;
+
+    ~EpochDomain() {
+        // No readers can exist during static destruction; free everything
+        for (auto& retired : retired_) {
+            retired.deleter(retired.ptr);
+        }
+        ThreadRecord* record = records_.load(std::memory_order_acquire);
+        while (record) {
+            ThreadRecord* next = record->next;
+            delete record;
+            record = next;
+        }
+    }
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /**
+     * @brief Get the process-wide reclamation domain
+     */
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    /**
+     * @brief Get (lazily registering) the calling thread's record
+     */
+    ThreadRecord& local_record() {
+        thread_local RecordHolder holder(*this);
+        return *holder.record;
+    }
+
+    /**
+     * @brief Enter a read-side critical section (re-entrant)
+     */
+    void enter(ThreadRecord& record) noexcept {
+        if (record.depth++ == 0) {
+            // seq_cst store pairs with the seq_cst scan in collect()
+            record.epoch.store(globalEpoch_.load(std::memory_order_acquire),
+                               std::memory_order_seq_cst);
+        }
+    }
+
+    /**
+     * @brief Leave a read-side critical section
+     */
+    void exit(ThreadRecord& record) noexcept {
+        if (--record.depth == 0) {
+            record.epoch.store(kIdleEpoch, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Retire an object that has been unlinked from all shared pointers
+     *
+     * The object is destroyed once no reader can still observe it. Must be
+     * called after the replacing pointer has been published.
+     */
+    template<typename T>
+    void retire(const T* ptr) {
+        if (!ptr) {
+            return;
+        }
+        retire_raw(const_cast<T*>(ptr), [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    /**
+     * @brief Wait until every read-side critical section open at the call has ended
+     *
+     * A grace period: afterwards no reader can still be using anything that
+     * was unlinked before the call, so it may be destroyed without retiring
+     * it. Sections of the calling thread are not waited for, which makes it
+     * callable from inside a guard; two threads waiting on each other's
+     * open sections this way would deadlock. Defined in src/EpochReclaimer.cpp.
+     */
+    void synchronize();
+
+    /**
+     * @brief Free every retired object that is no longer reachable by readers
+     *
+     * @return Number of objects freed
+     */
+    std::size_t collect() {
+        std::lock_guard lock(retireMutex_);
+        return collect_locked();
+    }
+
+private:
+    struct RetiredObject {
+        void* ptr;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+    struct RecordHolder {
+        ThreadRecord* record;
+
+        explicit RecordHolder(EpochDomain& domain) : record(domain.acquire_record()) {}
+        ~RecordHolder() {
+            record->epoch.store(kIdleEpoch, std::memory_order_release);
+            record->inUse.store(false, std::memory_order_release);
+        }
+    };
+
+    ThreadRecord* acquire_record() {
+        // Reuse a record released by an exited thread
+        for (ThreadRecord* record = records_.load(std::memory_order_acquire); record; record = record->next) {
+            bool expected = false;
+            if (!record->inUse.load(std::memory_order_relaxed) &&
+                record->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                return record;
+            }
+        }
+
+        auto* record = new ThreadRecord();
+        record->inUse.store(true, std::memory_order_relaxed);
+        ThreadRecord* head = records_.load(std::memory_order_relaxed);
+        do {
+            record->next = head;
+        } while (!records_.compare_exchange_weak(head, record,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+        return record;
+    }
+
+    void retire_raw(void* ptr, void (*deleter)(void*)) {
+        std::lock_guard lock(retireMutex_);
+        const std::uint64_t epoch = globalEpoch_.fetch_add(1, std::memory_order_seq_cst);
+        retired_.push_back(RetiredObject{ptr, deleter, epoch});
+        collect_locked();
+    }
+
+    std::size_t collect_locked() {
+        if (retired_.empty()) {
+            return 0;
+        }
+
+        std::uint64_t minActive = kIdleEpoch;
+        for (ThreadRecord* record = records_.load(std::memory_order_acquire); record; record = record->next) {
+            const std::uint64_t epoch = record->epoch.load(std::memory_order_seq_cst);
+            if (epoch < minActive) {
+                minActive = epoch;
+            }
+        }
+
+        // Readers that announced an epoch <= retired.epoch may still hold the object
+        std::size_t freedCount = 0;
+        auto keepIt = retired_.begin();
+        for (auto it = retired_.begin(); it != retired_.end(); ++it) {
+            if (it->epoch < minActive) {
+                it->deleter(it->ptr);
+                ++freedCount;
+            } else {
+                *keepIt++ = *it;
+            }
+        }
+        retired_.erase(keepIt, retired_.end());
+        return freedCount;
+    }
+
+    std::atomic<std::uint64_t> globalEpoch_{1};
+    std::atomic<ThreadRecord*> records_{nullptr};
+    std::mutex retireMutex_;
+    std::vector<RetiredObject> retired_;
+};
+
+/**
+ * @brief RAII read-side critical section on the global epoch domain
+ *
+ * Any pointer loaded from an epoch-protected atomic while the guard is alive
+ * remains valid until the guard is destroyed. Guards may be nested.
+ */
+class EpochGuard {
+public:
+    EpochGuard()
+        : domain_(EpochDomain::instance()), record_(domain_.local_record()) {
+        domain_.enter(record_);
+    }
+
+    ~EpochGuard() {
+        domain_.exit(record_);
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+private:
+    EpochDomain& domain_;
+    EpochDomain::ThreadRecord& record_;
+};
+
+} // namespace detail
+} // namespace EventCore
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
 namespace EventCore {
 
 /**
@@ -18,4 +22,149 @@ struct Event {
     virtual ~Event() = default;
 };
 
+/**
+ * @brief Event priority levels for controlling execution order
+ * 
+ * Higher values execute first. This allows critical system events
+ * to run before less important events like UI updates. Listener
+ * priorities order the callbacks of one event; an event type's own
+ * priority (see PrioritizedEvent) picks its deferred-queue lane.
+ */
+enum class EventPriority : int {
+    Low = 0,        // UI updates, non-critical notifications
+    Normal = 1,     // Default priority for most game events  
+    High = 2,       // Critical system events, state changes
+    Critical = 3    // Emergency events, error handling
+};
+
+/**
+ * @brief Result a consuming handler returns to control propagation
+ * 
+ * Handlers may return EventResult instead of void. Returning Consumed stops
+ * the dispatch of that event: lower-priority listeners (and later listeners
+ * of the same priority) are not invoked. void handlers never stop it.
+ * 
+ * Example usage:
+ * EventResult UiLayer::on_click(const MouseClickEvent& e) {
+ *     return hit_test(e.x, e.y) ? EventResult::Consumed : EventResult::Continue;
+ * }
+ */
+enum class EventResult : int {
+    Continue = 0,   // Let the remaining listeners see the event
+    Consumed = 1    // Stop propagation
+};
+
+/**
+ * @brief Return types accepted from event handlers
+ */
+template<typename ResultT>
+concept EventHandlerResult = std::same_as<ResultT, void> || std::same_as<ResultT, EventResult>;
+
+/**
+ * @brief Event types that expose a routing/ordering key
+ * 
+ * An event opts in by providing a const event_key() member convertible to
+ * std::uint64_t (an entity ID, connection ID, channel, ...). Keys are used
+ * to partition work, e.g. per-key ordering in parallel processing.
+ * 
+ * Example usage:
+ * struct EntityMovedEvent : public Event {
+ *     std::uint32_t entityId;
+ *     std::uint64_t event_key() const { return entityId; }
+ * };
+ */
+template<typename EventT>
+concept KeyedEvent = requires(const EventT& event) {
+    { event.event_key() } -> std::convertible_to<std::uint64_t>;
+};
+
+/**
+ * @brief Keyed event types whose deferred copies coalesce (last value wins)
+ * 
+ * An event opts in with a static constexpr bool event_coalescing = true
+ * member on top of event_key(). While an event with a given key is waiting
+ * in the deferred queue, enqueueing another one with the same key replaces
+ * it in place: listeners see only the newest value, at the queue position
+ * of the first one. Immediate dispatch is unaffected.
+ * 
+ * Example usage:
+ * struct EntityMovedEvent : public Event {
+ *     static constexpr bool event_coalescing = true;
+ *     std::uint32_t entityId;
+ *     float x, y;
+ *     std::uint64_t event_key() const { return entityId; }
+ * };
+ */
+template<typename EventT>
+concept CoalescingEvent = KeyedEvent<EventT> && requires {
+    requires EventT::event_coalescing;
+};
+
+/**
+ * @brief Event types that declare a base event type (event hierarchies)
+ * 
+ * A type opts in with a using event_base = BaseEvent; member naming the
+ * event class it derives from. Listeners of BaseEvent (and of BaseEvent's
+ * own declared bases) then also receive it. Each level of a hierarchy
+ * declares its own event_base: a class that does not inherits its parent's
+ * declaration and becomes a sibling of its parent rather than a child.
+ * The base must be a non-virtual base class (checked at compile time).
+ * 
+ * Example usage:
+ * struct DamageEvent : public Event {
+ *     int amount;
+ * };
+ * struct FireDamageEvent : public DamageEvent {
+ *     using event_base = DamageEvent;
+ *     float burnSeconds;
+ * };
+ */
+template<typename EventT>
+concept HierarchicalEvent = requires {
+    typename EventT::event_base;
+};
+
+/**
+ * @brief Event types that choose their deferred-queue priority lane
+ * 
+ * An event opts in with a static constexpr EventPriority event_priority
+ * member. Deferred copies wait in that priority's lane of the queue, and
+ * process_queued_events() drains higher lanes first, so a Critical event
+ * overtakes a backlog of Low ones. Types without it use the Normal lane.
+ * Immediate dispatch is unaffected; listener priorities still order the
+ * callbacks of each event.
+ * 
+ * Example usage:
+ * struct ConnectionLostEvent : public Event {
+ *     static constexpr EventPriority event_priority = EventPriority::Critical;
+ *     std::uint64_t connectionId;
+ * };
+ */
+template<typename EventT>
+concept PrioritizedEvent = requires {
+    { EventT::event_priority } -> std::convertible_to<EventPriority>;
+};
+
+/**
+ * @brief Event types that an EventRecorder may capture byte for byte
+ * 
+ * An event opts in with a static constexpr bool event_recordable = true
+ * member when its data members are plain values (numbers, enums, fixed
+ * arrays; no pointers, strings or owning members). Recording copies the
+ * bytes that follow the Event base; replay default-constructs the event and
+ * copies them back. The type must derive from Event through single
+ * inheritance only.
+ * 
+ * Example usage:
+ * struct InputSampledEvent : public Event {
+ *     static constexpr bool event_recordable = true;
+ *     std::uint32_t buttons = 0;
+ *     float stickX = 0.0f, stickY = 0.0f;
+ * };
+ */
+template<typename EventT>
+concept RecordableEvent = std::is_default_constructible_v<EventT> && requires {
+    requires EventT::event_recordable;
+};
+
 } // namespace EventCore 
\ No newline at end of file
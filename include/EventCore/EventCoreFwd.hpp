@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Event.hpp"
+#include "SubscriptionHandle.hpp"
+
+#include <cstdint>
+
+namespace EventCore {
+
+/**
+ * Forward declarations of the EventCore types
+ * 
+ * For headers that only name the dispatcher (pointers, references,
+ * subscription handles in members) without pulling in EventDispatcher.hpp
+ * and its third-party dependencies. Event and SubscriptionHandle are
+ * complete; everything else is declared only.
+ * 
+ * Example:
+ * #include <EventCore/EventCoreFwd.hpp>
+ * 
+ * class HudController {
+ * public:
+ *     explicit HudController(EventCore::EventDispatcher& dispatcher);
+ *     ~HudController();
+ * 
+ * private:
+ *     EventCore::EventDispatcher& dispatcher_;
+ *     EventCore::SubscriptionHandle healthHandle_;
+ * };
+ */
+
+class EventDispatcher;
+class ScopedSubscription;
+class ThreadPool;
+class ThreadAffineDispatcher;
+class LocalDispatcher;
+class EventRecorder;
+class EventReplayer;
+class SharedPayload;
+
+struct DispatcherConfig;
+struct QueuePolicy;
+struct CleanupPolicy;
+struct LaneBudget;
+struct WaitStrategy;
+struct ListenerConcurrency;
+struct InstrumentationSnapshot;
+
+template<typename EventT, typename Predicate>
+class EventAwaiter;
+
+enum class DeferredOrder : int;
+enum class ParallelOrder : int;
+enum class OverflowPolicy : int;
+enum class RecordKind : std::uint8_t;
+enum class ReplayRate : int;
+
+} // namespace EventCore
@@ -1,11 +1,20 @@
 #pragma once
 
+#include "Event.hpp"
+
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace EventCore {
 
 using EventTypeId = std::uint64_t;
+using EventTypeIndex = std::uint32_t;
 
 namespace detail {
 
@@ -75,4 +84,192 @@ constexpr EventTypeId get_event_type_id() noexcept {
  */
 #define EVENT_TYPE_ID(EventType) ::EventCore::get_event_type_id<EventType>()
 
+namespace detail {
+
+/**
+ * @brief Converts a pointer to a derived event into a pointer to one of its base subobjects
+ */
+using EventUpcast = const void* (*)(const void* eventData);
+
+template<typename DerivedT, typename BaseT>
+const void* upcast_event(const void* eventData) noexcept {
+    return static_cast<const BaseT*>(static_cast<const DerivedT*>(eventData));
+}
+
+/**
+ * @brief Process-wide registry assigning dense indices to event types
+ * 
+ * Types are keyed by their EventTypeId, so every module that instantiates
+ * get_event_type_index<EventT>() receives the same index for the same type.
+ * The registry is only consulted the first time a type is seen.
+ * 
+ * Intentionally immortal, like the event pool registry: types may still be
+ * registered during static destruction.
+ */
+class EventTypeRegistry {
+public:
+    static constexpr EventTypeIndex kNoParent = ~EventTypeIndex{0};
+    
+    /**
+     * @brief A declared base type of an event type
+     */
+    struct Ancestor {
+        EventTypeIndex index;
+        EventUpcast upcast;         // Derived event pointer -> this ancestor's subobject
+    };
+    
+    /**
+     * @brief Get the index of a type id, assigning the next free one if new
+     * 
+     * @param parent Index of the type's declared event_base (kNoParent if none)
+     * @param upcasts Conversions from the type to each of its ancestors, nearest first
+     */
+    static EventTypeIndex register_type(EventTypeId typeId, EventTypeIndex parent = kNoParent,
+                                        std::vector<EventUpcast> upcasts = {}) {
+        Registry& registry = instance();
+        std::lock_guard lock(registry.mutex);
+        
+        for (std::size_t i = 0; i < registry.typeIds.size(); ++i) {
+            if (registry.typeIds[i] == typeId) {
+                return static_cast<EventTypeIndex>(i);
+            }
+        }
+        registry.typeIds.push_back(typeId);
+        registry.parents.push_back(parent);
+        registry.upcasts.push_back(std::move(upcasts));
+        if (parent != kNoParent) {
+            hierarchyGeneration_.fetch_add(1, std::memory_order_release);
+        }
+        return static_cast<EventTypeIndex>(registry.typeIds.size() - 1);
+    }
+    
+    /**
+     * @brief Declared base types of an event type, nearest first
+     * 
+     * Each upcast converts a pointer to the derived event itself (not to
+     * the previous ancestor) into that ancestor's subobject.
+     */
+    static std::vector<Ancestor> ancestors(EventTypeIndex index) {
+        Registry& registry = instance();
+        std::lock_guard lock(registry.mutex);
+        
+        std::vector<Ancestor> result;
+        const std::vector<EventUpcast>& upcasts = registry.upcasts.at(index);
+        for (EventTypeIndex parent = registry.parents[index]; parent != kNoParent; parent = registry.parents[parent]) {
+            result.push_back(Ancestor{parent, upcasts[result.size()]});
+        }
+        return result;
+    }
+    
+    /**
+     * @brief Indices of every registered type that declares an event_base
+     */
+    static std::vector<EventTypeIndex> derived_types() {
+        Registry& registry = instance();
+        std::lock_guard lock(registry.mutex);
+        
+        std::vector<EventTypeIndex> result;
+        for (std::size_t i = 0; i < registry.parents.size(); ++i) {
+            if (registry.parents[i] != kNoParent) {
+                result.push_back(static_cast<EventTypeIndex>(i));
+            }
+        }
+        return result;
+    }
+    
+    /**
+     * @brief Bumped every time a type that declares an event_base is registered
+     * 
+     * Lets dispatchers notice new hierarchy members with a single load.
+     */
+    static std::uint32_t hierarchy_generation() noexcept {
+        return hierarchyGeneration_.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Get the EventTypeId an index was assigned to
+     */
+    static EventTypeId type_id(EventTypeIndex index) {
+        Registry& registry = instance();
+        std::lock_guard lock(registry.mutex);
+        return registry.typeIds.at(index);
+    }
+    
+    /**
+     * @brief Number of event types registered so far
+     */
+    static std::size_t type_count() {
+        Registry& registry = instance();
+        std::lock_guard lock(registry.mutex);
+        return registry.typeIds.size();
+    }
+    
+private:
+    struct Registry {
+        std::mutex mutex;
+        std::vector<EventTypeId> typeIds;                   // Indexed by EventTypeIndex
+        std::vector<EventTypeIndex> parents;                // Indexed by EventTypeIndex
+        std::vector<std::vector<EventUpcast>> upcasts;      // Indexed by EventTypeIndex, one per ancestor
+    };
+    
+    static Registry& instance() {
+        static Registry* registry = new Registry();
+        return *registry;
+    }
+    
+    static inline std::atomic<std::uint32_t> hierarchyGeneration_{0};
+};
+
+/**
+ * @brief Append the upcasts from DerivedT to BaseT and each of BaseT's declared bases
+ */
+template<typename DerivedT, typename BaseT>
+void collect_upcasts(std::vector<EventUpcast>& upcasts) {
+    upcasts.push_back(&upcast_event<DerivedT, BaseT>);
+    if constexpr (HierarchicalEvent<BaseT>) {
+        collect_upcasts<DerivedT, typename BaseT::event_base>(upcasts);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Get the dense runtime index of an event type
+ * 
+ * Indices are small sequential integers assigned the first time each type
+ * is used, which lets dispatchers index flat arrays instead of hashing the
+ * EventTypeId. They are stable for the lifetime of the process but depend
+ * on registration order, so use get_event_type_id() for anything that is
+ * persisted or exchanged between processes.
+ * 
+ * After the first call this is a single initialized-static check.
+ * 
+ * Example usage:
+ * const auto index = get_event_type_index<PlayerDiedEvent>();
+ */
+template<typename EventT>
+EventTypeIndex get_event_type_index() {
+    static_assert(std::is_base_of_v<Event, EventT>, 
+                  "EventT must inherit from EventCore::Event");
+    
+    static const EventTypeIndex index = [] {
+        if constexpr (HierarchicalEvent<EventT>) {
+            using BaseT = typename EventT::event_base;
+            static_assert(std::is_base_of_v<BaseT, EventT> && !std::is_same_v<BaseT, EventT>,
+                          "event_base must name a base class of the event type");
+            // A downcast only compiles from a non-virtual, unambiguous base
+            static_assert(requires(const BaseT* base) { static_cast<const EventT*>(base); },
+                          "event_base must be a non-virtual base class of the event type");
+            
+            std::vector<detail::EventUpcast> upcasts;
+            detail::collect_upcasts<EventT, BaseT>(upcasts);
+            return detail::EventTypeRegistry::register_type(get_event_type_id<EventT>(),
+                get_event_type_index<BaseT>(), std::move(upcasts));
+        } else {
+            return detail::EventTypeRegistry::register_type(get_event_type_id<EventT>());
+        }
+    }();
+    return index;
+}
+
 } // namespace EventCore 
\ No newline at end of file
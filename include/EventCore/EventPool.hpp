@@ -0,0 +1,211 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace EventCore {
+namespace detail {
+
+/**
+ * @brief Size-classed slab allocator for deferred event storage
+ *
+ * Every thread owns a SlabCache with one free list per size class. Blocks
+ * are carved from 64 KiB slabs and never returned to the system, so a
+ * steady enqueue/process rate performs no heap allocations after warm-up.
+ *
+ * Blocks are usually allocated by producer threads and freed by the
+ * consumer thread. A block freed by a thread other than its owner is pushed
+ * onto the owner's lock-free remote list, which the owner reclaims in one
+ * exchange when its local list runs dry. Caches of exited threads are
+ * adopted by new threads, so remote frees always have a valid target.
+ *
+ * Requests larger than the biggest size class fall through to the global
+ * operator new.
+ */
+class EventPool {
+public:
+    static constexpr std::size_t kHeaderSize = 16;                 // Keeps payload 16-byte aligned
+    static constexpr std::size_t kMinBlockShift = 6;               // 64-byte blocks
+    static constexpr std::size_t kClassCount = 7;                  // 64 B .. 4 KiB blocks
+    static constexpr std::size_t kSlabSize = 64 * 1024;
+    static constexpr std::size_t kMaxPooledSize =
+        (std::size_t{1} << (kMinBlockShift + kClassCount - 1)) - kHeaderSize;
+
+    /**
+     * @brief Allocate storage for an object of the given size (16-byte aligned)
+     */
+    static void* allocate(std::size_t size) {
+        if (size > kMaxPooledSize) {
+            return ::operator new(size);
+        }
+        return local_cache().allocate(size_class(size));
+    }
+
+    /**
+     * @brief Return storage obtained from allocate() with the same size
+     */
+    static void deallocate(void* ptr, std::size_t size) noexcept {
+        if (!ptr) {
+            return;
+        }
+        if (size > kMaxPooledSize) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        auto* header = reinterpret_cast<BlockHeader*>(static_cast<unsigned char*>(ptr) - kHeaderSize);
+        auto* block = reinterpret_cast<FreeBlock*>(header);
+        SlabCache* owner = header->owner;
+        const std::size_t sizeClass = header->sizeClass;
+
+        if (owner == current_cache()) {
+            owner->push_local(sizeClass, block);
+        } else {
+            owner->push_remote(sizeClass, block);
+        }
+    }
+
+private:
+    struct SlabCache;
+
+    struct BlockHeader {
+        SlabCache* owner;
+        std::size_t sizeClass;
+    };
+
+    struct FreeBlock {
+        BlockHeader header;      // Preserved across free/allocate cycles
+        FreeBlock* next;         // Overlays the payload while the block is free
+    };
+
+    struct alignas(64) SlabCache {
+        FreeBlock* localFree[kClassCount] = {};                     // Owner thread only
+        alignas(64) std::atomic<FreeBlock*> remoteFree[kClassCount] = {};
+        std::atomic<bool> inUse{false};
+        SlabCache* next = nullptr;
+        std::vector<void*> slabs;
+
+        void* allocate(std::size_t sizeClass) {
+            FreeBlock* block = localFree[sizeClass];
+            if (!block) {
+                // Reclaim everything other threads have freed back to us
+                block = remoteFree[sizeClass].exchange(nullptr, std::memory_order_acquire);
+                if (!block) {
+                    block = carve_slab(sizeClass);
+                }
+            }
+            localFree[sizeClass] = block->next;
+            return reinterpret_cast<unsigned char*>(block) + kHeaderSize;
+        }
+
+        void push_local(std::size_t sizeClass, FreeBlock* block) noexcept {
+            block->next = localFree[sizeClass];
+            localFree[sizeClass] = block;
+        }
+
+        void push_remote(std::size_t sizeClass, FreeBlock* block) noexcept {
+            FreeBlock* head = remoteFree[sizeClass].load(std::memory_order_relaxed);
+            do {
+                block->next = head;
+            } while (!remoteFree[sizeClass].compare_exchange_weak(head, block,
+                                                                  std::memory_order_release,
+                                                                  std::memory_order_relaxed));
+        }
+
+        FreeBlock* carve_slab(std::size_t sizeClass) {
+            const std::size_t blockSize = std::size_t{1} << (kMinBlockShift + sizeClass);
+            auto* slab = static_cast<unsigned char*>(::operator new(kSlabSize));
+            slabs.push_back(slab);
+
+            FreeBlock* head = nullptr;
+            for (std::size_t offset = kSlabSize; offset >= blockSize; offset -= blockSize) {
+                auto* block = reinterpret_cast<FreeBlock*>(slab + offset - blockSize);
+                block->header.owner = this;
+                block->header.sizeClass = sizeClass;
+                block->next = head;
+                head = block;
+            }
+            return head;
+        }
+    };
+
+    /**
+     * @brief Registry of all caches ever created
+     *
+     * Intentionally immortal: events may be freed during static destruction
+     * (e.g. by a global dispatcher), after any function-local static would
+     * already be gone.
+     */
+    struct Registry {
+        std::mutex mutex;
+        SlabCache* head = nullptr;
+
+        SlabCache* acquire() {
+            std::lock_guard lock(mutex);
+            for (SlabCache* cache = head; cache; cache = cache->next) {
+                if (!cache->inUse.load(std::memory_order_relaxed)) {
+                    cache->inUse.store(true, std::memory_order_relaxed);
+                    return cache;
+                }
+            }
+            auto* cache = new SlabCache();
+            cache->inUse.store(true, std::memory_order_relaxed);
+            cache->next = head;
+            head = cache;
+            return cache;
+        }
+
+        void release(SlabCache* cache) {
+            std::lock_guard lock(mutex);
+            cache->inUse.store(false, std::memory_order_relaxed);
+        }
+    };
+
+    struct CacheHolder {
+        SlabCache* cache;
+        CacheHolder() : cache(registry().acquire()) {}
+        ~CacheHolder() {
+            // Later frees on this thread take the remote path
+            current_cache_slot() = nullptr;
+            registry().release(cache);
+        }
+    };
+
+    static Registry& registry() {
+        static Registry* instance = new Registry();
+        return *instance;
+    }
+
+    static SlabCache*& current_cache_slot() noexcept {
+        thread_local SlabCache* cache = nullptr;
+        return cache;
+    }
+
+    static SlabCache* current_cache() noexcept {
+        return current_cache_slot();
+    }
+
+    static SlabCache& local_cache() {
+        SlabCache*& slot = current_cache_slot();
+        if (!slot) {
+            thread_local CacheHolder holder;
+            slot = holder.cache;
+        }
+        return *slot;
+    }
+
+    static constexpr std::size_t size_class(std::size_t size) noexcept {
+        std::size_t sizeClass = 0;
+        while ((std::size_t{1} << (kMinBlockShift + sizeClass)) < size + kHeaderSize) {
+            ++sizeClass;
+        }
+        return sizeClass;
+    }
+};
+
+} // namespace detail
+} // namespace EventCore
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "Event.hpp"
+#include "EventId.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace EventCore {
+
+/**
+ * @brief How a recorded event entered the dispatcher
+ */
+enum class RecordKind : std::uint8_t {
+    Dispatch = 0,       // dispatch() / dispatch_batch()
+    Enqueue = 1         // enqueue(), emplace(), enqueue_bulk() and their Producer forms
+};
+
+namespace detail {
+
+/**
+ * @brief Read-only or read-write memory mapping of a whole file
+ *
+ * Implemented per platform in src/EventRecorder.cpp, which keeps the OS
+ * headers out of this header. A write mapping creates (or truncates) the
+ * file at the requested capacity; close() shrinks it to the bytes used.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open_for_write(const std::string& path, std::size_t capacity) noexcept;
+    bool open_for_read(const std::string& path) noexcept;
+
+    /**
+     * @brief Unmap; a write mapping first truncates the file to usedSize bytes
+     */
+    void close(std::size_t usedSize = 0) noexcept;
+
+    std::byte* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+private:
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool writable_ = false;
+#if defined(_WIN32)
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+/**
+ * @brief First bytes of a recording
+ *
+ * dataSize stays 0 until the recorder is closed; a replayer then scans the
+ * whole file up to the first all-zero record header.
+ */
+struct RecordingHeader {
+    static constexpr std::uint32_t kMagic = 0x4C524345;     // "ECRL"
+    static constexpr std::uint32_t kVersion = 1;
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t dataSize;         // Record bytes following the header
+    std::uint64_t recordCount;
+    std::uint64_t reserved;
+};
+
+/**
+ * @brief Fixed header in front of each record's payload
+ *
+ * The payload (the event bytes after its Event base) follows directly and
+ * is padded to kRecordAlignment.
+ */
+struct RecordHeader {
+    static constexpr std::size_t kRecordAlignment = 8;
+
+    EventTypeId typeId;
+    std::uint64_t timestamp;        // Nanoseconds since the recording started
+    std::uint32_t size;             // Payload bytes
+    RecordKind kind;
+    std::uint8_t reserved[3];
+
+    static constexpr std::size_t record_size(std::size_t payloadSize) noexcept {
+        return sizeof(RecordHeader) + (payloadSize + kRecordAlignment - 1) / kRecordAlignment * kRecordAlignment;
+    }
+};
+
+static_assert(sizeof(RecordingHeader) == 32 && sizeof(RecordHeader) == 24,
+              "Recording layout is part of the file format");
+
+/**
+ * @brief Bytes of a recordable event that follow its Event base
+ */
+template<typename EventT>
+inline constexpr std::size_t recorded_size = sizeof(EventT) - sizeof(Event);
+
+} // namespace detail
+
+/**
+ * @brief Appends events to a binary, memory-mapped log for later replay
+ *
+ * The log file is created at its full capacity (sparse where the file
+ * system allows) and mapped once, so recording an event is a compare-and-
+ * swap on the write offset, a clock read and two memcpys into the mapping,
+ * from any number of threads. Nothing is flushed or locked on the way; once
+ * the capacity is used up further events are counted as dropped. close()
+ * (or the destructor) writes the final sizes and truncates the file.
+ *
+ * Only RecordableEvent types are recorded; records are keyed by the
+ * persistent EventTypeId, so a recording can be replayed by another build
+ * of the program (see EventReplayer).
+ *
+ * Attach a recorder to a dispatcher to capture everything passing through
+ * its dispatch and enqueue calls (scheduled events are not captured):
+ *
+ * EventCore::EventRecorder recorder("session.ecrl");
+ * dispatcher.attach_recorder(&recorder);
+ * // ... run ...
+ * dispatcher.attach_recorder(nullptr);
+ * recorder.close();
+ *
+ * Thread Safety: record() is thread-safe and lock-free. close() must not
+ * run concurrently with record(); detach the recorder first.
+ */
+class EventRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t kDefaultCapacity = std::size_t{256} << 20;
+
+    /**
+     * @param path Log file to create (an existing file is replaced)
+     * @param capacity Maximum file size in bytes
+     *
+     * Check is_open() afterwards; the file may not be creatable.
+     */
+    explicit EventRecorder(const std::string& path, std::size_t capacity = kDefaultCapacity)
+        : start_(Clock::now()) {
+        if (capacity >= sizeof(detail::RecordingHeader) && file_.open_for_write(path, capacity)) {
+            const detail::RecordingHeader header{detail::RecordingHeader::kMagic,
+                                                 detail::RecordingHeader::kVersion, 0, 0, 0};
+            std::memcpy(file_.data(), &header, sizeof(header));
+            offset_.store(sizeof(header), std::memory_order_relaxed);
+        }
+    }
+
+    ~EventRecorder() {
+        close();
+    }
+
+    EventRecorder(const EventRecorder&) = delete;
+    EventRecorder& operator=(const EventRecorder&) = delete;
+
+    bool is_open() const noexcept { return file_.data() != nullptr; }
+
+    /**
+     * @brief Append one event
+     *
+     * @return false if the recorder is closed or full (the event is counted as dropped)
+     */
+    template<RecordableEvent EventT>
+    bool record(const EventT& event, RecordKind kind = RecordKind::Dispatch) noexcept {
+        const auto* bytes = reinterpret_cast<const std::byte*>(std::addressof(event));
+        return append(get_event_type_id<EventT>(), kind, bytes + sizeof(Event), detail::recorded_size<EventT>);
+    }
+
+    /**
+     * @brief Append a record with an explicit type ID and payload
+     */
+    bool append(EventTypeId typeId, RecordKind kind, const void* payload, std::size_t size) noexcept {
+        if (!is_open()) {
+            return false;
+        }
+
+        const std::size_t recordSize = detail::RecordHeader::record_size(size);
+        std::size_t begin = offset_.load(std::memory_order_relaxed);
+        do {
+            if (recordSize > file_.size() - begin) {
+                droppedCount_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!offset_.compare_exchange_weak(begin, begin + recordSize, std::memory_order_relaxed));
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_);
+        const detail::RecordHeader header{typeId, static_cast<std::uint64_t>(elapsed.count()),
+                                          static_cast<std::uint32_t>(size), kind, {}};
+        std::byte* out = file_.data() + begin;
+        std::memcpy(out, &header, sizeof(header));
+        std::memcpy(out + sizeof(header), payload, size);
+
+        recordedCount_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Finalize the header and truncate the file to the recorded bytes
+     */
+    void close() noexcept {
+        if (!is_open()) {
+            return;
+        }
+
+        const std::size_t used = offset_.load(std::memory_order_acquire);
+        detail::RecordingHeader header;
+        std::memcpy(&header, file_.data(), sizeof(header));
+        header.dataSize = used - sizeof(header);
+        header.recordCount = recordedCount_.load(std::memory_order_relaxed);
+        std::memcpy(file_.data(), &header, sizeof(header));
+        file_.close(used);
+    }
+
+    std::size_t recorded_count() const noexcept { return recordedCount_.load(std::memory_order_relaxed); }
+    std::size_t dropped_count() const noexcept { return droppedCount_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Bytes of the log used so far (file header included)
+     */
+    std::size_t size_bytes() const noexcept { return offset_.load(std::memory_order_relaxed); }
+
+private:
+    detail::MappedFile file_;
+    const Clock::time_point start_;
+
+    alignas(64) std::atomic<std::size_t> offset_{0};       // Next free byte of the mapping
+    alignas(64) std::atomic<std::size_t> recordedCount_{0};
+    std::atomic<std::size_t> droppedCount_{0};
+};
+
+} // namespace EventCore
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "EventDispatcher.hpp"
+#include "EventRecorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <robin_hood.h>
+
+namespace EventCore {
+
+/**
+ * @brief Pacing of EventReplayer::replay()
+ */
+enum class ReplayRate : int {
+    Maximal = 0,        // Back to back, as fast as the dispatcher takes them
+    Recorded = 1        // Each event at its recorded offset from the start of the replay
+};
+
+/**
+ * @brief Outcome of one replay pass
+ */
+struct ReplayResult {
+    std::size_t replayed = 0;               // Events dispatched or enqueued
+    std::size_t skipped = 0;                // Records of unregistered types or with a different size
+    std::chrono::nanoseconds elapsed{0};
+};
+
+/**
+ * @brief Streams an EventRecorder log back into an EventDispatcher
+ *
+ * The log is memory-mapped read-only and walked sequentially. Each record
+ * is turned back into its event by the handler registered for its
+ * EventTypeId, then dispatched or enqueued the way it was recorded;
+ * enqueued events wait for the caller's process_queued_events() as usual.
+ * Replaying a recording at ReplayRate::Maximal makes a repeatable
+ * throughput test of the listeners it reaches.
+ *
+ * Types must be registered before replay; records of other types are
+ * skipped, as are records whose size no longer matches the type (the
+ * event's layout changed since the recording).
+ *
+ * Example:
+ * EventCore::EventReplayer replayer("session.ecrl");
+ * replayer.register_type<InputSampledEvent>();
+ * replayer.register_type<PacketReceivedEvent>();
+ * const auto result = replayer.replay(dispatcher, EventCore::ReplayRate::Recorded);
+ * dispatcher.process_queued_events();
+ */
+class EventReplayer {
+public:
+    /**
+     * @param path Log written by an EventRecorder
+     *
+     * Check is_open() afterwards; the file may be missing or not a recording.
+     */
+    explicit EventReplayer(const std::string& path) {
+        if (!file_.open_for_read(path) || file_.size() < sizeof(detail::RecordingHeader)) {
+            file_.close();
+            return;
+        }
+
+        detail::RecordingHeader header;
+        std::memcpy(&header, file_.data(), sizeof(header));
+        if (header.magic != detail::RecordingHeader::kMagic ||
+            header.version != detail::RecordingHeader::kVersion) {
+            file_.close();
+            return;
+        }
+
+        // A recorder that was never closed leaves dataSize at 0: scan the whole file
+        const std::size_t available = file_.size() - sizeof(header);
+        dataSize_ = header.dataSize != 0 ? std::min<std::size_t>(header.dataSize, available) : available;
+        recordCount_ = header.recordCount;
+    }
+
+    EventReplayer(const EventReplayer&) = delete;
+    EventReplayer& operator=(const EventReplayer&) = delete;
+
+    bool is_open() const noexcept { return file_.data() != nullptr; }
+
+    /**
+     * @brief Number of records the recorder wrote (0 if it was not closed)
+     */
+    std::size_t record_count() const noexcept { return recordCount_; }
+
+    /**
+     * @brief Enable replay of an event type
+     */
+    template<RecordableEvent EventT>
+    void register_type() {
+        handlers_[get_event_type_id<EventT>()] = &replay_record<EventT>;
+    }
+
+    /**
+     * @brief Feed every record of the log into a dispatcher, in recorded order
+     *
+     * Runs on the calling thread; can be called repeatedly.
+     */
+    ReplayResult replay(EventDispatcher& dispatcher, ReplayRate rate = ReplayRate::Maximal) const {
+        ReplayResult result;
+        if (!is_open()) {
+            return result;
+        }
+
+        const std::byte* cursor = file_.data() + sizeof(detail::RecordingHeader);
+        const std::byte* const end = cursor + dataSize_;
+
+        // Records of one type tend to come in runs; skip the map probe for them
+        EventTypeId lastTypeId = 0;
+        Handler lastHandler = nullptr;
+
+        const auto start = std::chrono::steady_clock::now();
+        while (static_cast<std::size_t>(end - cursor) >= sizeof(detail::RecordHeader)) {
+            detail::RecordHeader header;
+            std::memcpy(&header, cursor, sizeof(header));
+            const std::size_t recordSize = detail::RecordHeader::record_size(header.size);
+            if (header.typeId == 0 || recordSize > static_cast<std::size_t>(end - cursor)) {
+                break;  // Zero-filled tail of an unclosed recording
+            }
+
+            if (header.typeId != lastTypeId) {
+                const auto it = handlers_.find(header.typeId);
+                lastTypeId = header.typeId;
+                lastHandler = it != handlers_.end() ? it->second : nullptr;
+            }
+
+            if (rate == ReplayRate::Recorded) {
+                std::this_thread::sleep_until(start + std::chrono::nanoseconds(header.timestamp));
+            }
+
+            if (lastHandler && lastHandler(dispatcher, cursor + sizeof(header), header.size, header.kind)) {
+                ++result.replayed;
+            } else {
+                ++result.skipped;
+            }
+            cursor += recordSize;
+        }
+
+        result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        return result;
+    }
+
+private:
+    using Handler = bool (*)(EventDispatcher& dispatcher, const std::byte* payload, std::size_t size, RecordKind kind);
+
+    template<typename EventT>
+    static bool replay_record(EventDispatcher& dispatcher, const std::byte* payload, std::size_t size,
+                              RecordKind kind) {
+        if (size != detail::recorded_size<EventT>) {
+            return false;
+        }
+
+        EventT event{};
+        std::memcpy(reinterpret_cast<std::byte*>(std::addressof(event)) + sizeof(Event), payload, size);
+        if (kind == RecordKind::Enqueue) {
+            dispatcher.enqueue(std::move(event));
+        } else {
+            dispatcher.dispatch(event);
+        }
+        return true;
+    }
+
+    detail::MappedFile file_;
+    std::size_t dataSize_ = 0;
+    std::size_t recordCount_ = 0;
+    robin_hood::unordered_flat_map<EventTypeId, Handler> handlers_;
+};
+
+} // namespace EventCore
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Set to 1 (CMake: -DEVENTCORE_ENABLE_INSTRUMENTATION=ON) to record
+// per-event-type and per-listener timings in EventDispatcher.
+#ifndef EVENTCORE_ENABLE_INSTRUMENTATION
+#define EVENTCORE_ENABLE_INSTRUMENTATION 0
+#endif
+
+namespace EventCore {
+
+/**
+ * @brief True when dispatcher instrumentation is compiled in
+ */
+inline constexpr bool kInstrumentationEnabled = EVENTCORE_ENABLE_INSTRUMENTATION != 0;
+
+/**
+ * @brief Point-in-time copy of a latency distribution
+ *
+ * Bucket b counts samples in [2^b, 2^(b+1)) nanoseconds (bucket 0 also
+ * holds 0 ns); the last bucket is open-ended.
+ */
+struct LatencyHistogram {
+    static constexpr std::size_t kBucketCount = 32;
+
+    std::uint64_t count = 0;
+    std::uint64_t totalNanoseconds = 0;
+    std::uint64_t maxNanoseconds = 0;
+    std::array<std::uint64_t, kBucketCount> buckets{};
+
+    static constexpr std::size_t bucket_of(std::uint64_t nanoseconds) noexcept {
+        return std::min<std::size_t>(kBucketCount - 1, std::bit_width(nanoseconds | 1) - 1);
+    }
+
+    double mean_nanoseconds() const noexcept {
+        return count ? static_cast<double>(totalNanoseconds) / static_cast<double>(count) : 0.0;
+    }
+
+    /**
+     * @brief Upper bound of the bucket holding the given quantile (0..1)
+     *
+     * Accurate to a factor of two, never above the recorded maximum.
+     */
+    std::uint64_t percentile_nanoseconds(double quantile) const noexcept {
+        if (count == 0) {
+            return 0;
+        }
+        const double clamped = std::clamp(quantile, 0.0, 1.0);
+        const auto target = std::max<std::uint64_t>(1,
+            static_cast<std::uint64_t>(clamped * static_cast<double>(count) + 0.5));
+
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+            seen += buckets[bucket];
+            if (seen >= target) {
+                return std::min(maxNanoseconds, (std::uint64_t{1} << (bucket + 1)) - 1);
+            }
+        }
+        return maxNanoseconds;
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Monotonic timestamp used by the instrumentation layer
+ */
+inline std::uint64_t instrumentation_clock() noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Lock-free latency histogram (relaxed counters, any thread)
+ */
+class LatencyRecorder {
+public:
+    void record(std::uint64_t nanoseconds) noexcept {
+        count_.fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(nanoseconds, std::memory_order_relaxed);
+        buckets_[LatencyHistogram::bucket_of(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+
+        std::uint64_t previousMax = max_.load(std::memory_order_relaxed);
+        while (nanoseconds > previousMax &&
+               !max_.compare_exchange_weak(previousMax, nanoseconds, std::memory_order_relaxed)) {
+        }
+    }
+
+    LatencyHistogram snapshot() const noexcept {
+        LatencyHistogram histogram;
+        histogram.count = count_.load(std::memory_order_relaxed);
+        histogram.totalNanoseconds = total_.load(std::memory_order_relaxed);
+        histogram.maxNanoseconds = max_.load(std::memory_order_relaxed);
+        for (std::size_t bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket) {
+            histogram.buckets[bucket] = buckets_[bucket].load(std::memory_order_relaxed);
+        }
+        return histogram;
+    }
+
+    void reset() noexcept {
+        count_.store(0, std::memory_order_relaxed);
+        total_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> total_{0};
+    std::atomic<std::uint64_t> max_{0};
+    std::array<std::atomic<std::uint64_t>, LatencyHistogram::kBucketCount> buckets_{};
+};
+
+/**
+ * @brief Counters kept per event type
+ */
+struct EventTypeRecorder {
+    std::atomic<std::uint64_t> dispatches{0};
+    LatencyRecorder queueDwell;                 // Enqueue to dequeue
+
+    void reset() noexcept {
+        dispatches.store(0, std::memory_order_relaxed);
+        queueDwell.reset();
+    }
+};
+
+/**
+ * @brief Callback timings of every subscription slot
+ *
+ * Recorders live in fixed-size chunks that are allocated by the writer and
+ * never move or shrink, so dispatching threads find a slot's recorder with
+ * two loads and no lock. Slots beyond kChunkSize * kMaxChunks are not
+ * recorded.
+ */
+class ListenerRecorderTable {
+public:
+    static constexpr std::size_t kChunkSize = 256;
+    static constexpr std::size_t kMaxChunks = 4096;
+
+    ListenerRecorderTable() : chunks_(std::make_unique<std::atomic<LatencyRecorder*>[]>(kMaxChunks)) {}
+
+    ~ListenerRecorderTable() {
+        for (std::size_t chunk = 0; chunk < kMaxChunks; ++chunk) {
+            delete[] chunks_[chunk].load(std::memory_order_relaxed);
+        }
+    }
+
+    ListenerRecorderTable(const ListenerRecorderTable&) = delete;
+    ListenerRecorderTable& operator=(const ListenerRecorderTable&) = delete;
+
+    /**
+     * @brief Recorder of a slot (nullptr if the slot was never prepared)
+     */
+    LatencyRecorder* find(std::uint32_t slot) const noexcept {
+        const std::size_t chunk = slot / kChunkSize;
+        if (chunk >= kMaxChunks) {
+            return nullptr;
+        }
+        LatencyRecorder* recorders = chunks_[chunk].load(std::memory_order_acquire);
+        return recorders ? recorders + slot % kChunkSize : nullptr;
+    }
+
+    /**
+     * @brief Make a slot's recorder available and clear it (writer only)
+     */
+    void prepare(std::uint32_t slot) {
+        const std::size_t chunk = slot / kChunkSize;
+        if (chunk >= kMaxChunks) {
+            return;
+        }
+        LatencyRecorder* recorders = chunks_[chunk].load(std::memory_order_relaxed);
+        if (!recorders) {
+            recorders = new LatencyRecorder[kChunkSize];
+            chunks_[chunk].store(recorders, std::memory_order_release);
+        }
+        recorders[slot % kChunkSize].reset();
+    }
+
+private:
+    std::unique_ptr<std::atomic<LatencyRecorder*>[]> chunks_;
+};
+
+} // namespace detail
+} // namespace EventCore
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "EventPool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <utility>
+
+namespace EventCore {
+
+/**
+ * @brief Reference-counted byte buffer for large event payloads
+ *
+ * Events that carry bulk data (network packets, file chunks, serialized
+ * blobs) hold a SharedPayload instead of the bytes themselves, so moving
+ * or copying the event through the deferred queue moves or copies a single
+ * pointer. The buffer is allocated from the same slab pool as queued
+ * events (sizes up to EventPool::kMaxPooledSize) and is released by
+ * whichever thread drops the last handle.
+ *
+ * The producer fills the buffer through mutable_bytes() before publishing
+ * the event; after that the contents are shared and must be treated as
+ * read-only. Copying a handle is one atomic increment, moving is free.
+ *
+ * Example:
+ * SharedPayload payload = SharedPayload::allocate(packetSize);
+ * socket.read(payload.mutable_bytes());
+ * dispatcher.emplace<PacketReceivedEvent>(connectionId, std::move(payload));
+ */
+class SharedPayload {
+public:
+    SharedPayload() noexcept = default;
+
+    /**
+     * @brief Allocate an uninitialized buffer of size bytes (16-byte aligned)
+     */
+    static SharedPayload allocate(std::size_t size) {
+        void* block = detail::EventPool::allocate(sizeof(Header) + size);
+        return SharedPayload(::new (block) Header{size});
+    }
+
+    /**
+     * @brief Allocate a buffer holding a copy of size bytes at data
+     */
+    static SharedPayload copy_of(const void* data, std::size_t size) {
+        SharedPayload payload = allocate(size);
+        if (size != 0) {
+            std::memcpy(payload.mutable_data(), data, size);
+        }
+        return payload;
+    }
+
+    SharedPayload(const SharedPayload& other) noexcept : header_(other.header_) {
+        if (header_) {
+            header_->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SharedPayload(SharedPayload&& other) noexcept : header_(std::exchange(other.header_, nullptr)) {}
+
+    SharedPayload& operator=(SharedPayload other) noexcept {
+        std::swap(header_, other.header_);
+        return *this;
+    }
+
+    ~SharedPayload() {
+        release();
+    }
+
+    const std::byte* data() const noexcept { return header_ ? payload_of(header_) : nullptr; }
+    std::size_t size() const noexcept { return header_ ? header_->size : 0; }
+    bool empty() const noexcept { return size() == 0; }
+    explicit operator bool() const noexcept { return header_ != nullptr; }
+
+    std::span<const std::byte> bytes() const noexcept { return {data(), size()}; }
+
+    /**
+     * @brief Writable view of the buffer, for filling it before the payload is shared
+     */
+    std::byte* mutable_data() noexcept { return header_ ? payload_of(header_) : nullptr; }
+    std::span<std::byte> mutable_bytes() noexcept { return {mutable_data(), size()}; }
+
+    /**
+     * @brief Number of handles sharing the buffer (0 for an empty handle)
+     */
+    std::uint32_t use_count() const noexcept {
+        return header_ ? header_->references.load(std::memory_order_relaxed) : 0;
+    }
+
+private:
+    // Keeps the payload at the 16-byte alignment of the pool blocks
+    struct alignas(16) Header {
+        explicit Header(std::size_t bytes) noexcept : size(bytes) {}
+
+        std::atomic<std::uint32_t> references{1};
+        std::size_t size;
+    };
+
+    explicit SharedPayload(Header* header) noexcept : header_(header) {}
+
+    static std::byte* payload_of(Header* header) noexcept {
+        return reinterpret_cast<std::byte*>(header) + sizeof(Header);
+    }
+
+    void release() noexcept {
+        if (header_ && header_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            const std::size_t blockSize = sizeof(Header) + header_->size;
+            header_->~Header();
+            detail::EventPool::deallocate(header_, blockSize);
+        }
+        header_ = nullptr;
+    }
+
+    Header* header_ = nullptr;
+};
+
+} // namespace EventCore
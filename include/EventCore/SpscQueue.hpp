@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace EventCore {
+namespace detail {
+
+/**
+ * @brief Unbounded single-producer single-consumer queue
+ *
+ * Values live in fixed-size segments linked in push order. The producer
+ * constructs a value in the tail segment and publishes it with one release
+ * store of the segment's fill count; the consumer reads that count and
+ * takes everything published so far in one pass. Neither side uses a
+ * read-modify-write, and producer and consumer state sit on separate cache
+ * lines.
+ *
+ * When the producer fills the tail segment it links a new one. The consumer
+ * hands each exhausted segment back as a spare, so a queue that stays within
+ * two segments' worth of backlog does not allocate.
+ *
+ * push() must only be called from one thread at a time, and consume() and
+ * empty() from one (possibly different) thread at a time.
+ */
+template<typename T, std::size_t SegmentSize = 256>
+class SpscQueue {
+public:
+    SpscQueue() : head_(new Segment()), tail_(head_) {}
+
+    ~SpscQueue() {
+        consume([](T&) {}, ~std::size_t{0});
+        delete head_;
+        delete spare_.load(std::memory_order_relaxed);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Append a value (producer side)
+     */
+    void push(T&& value) {
+        if (tailIndex_ == SegmentSize) {
+            Segment* next = spare_.exchange(nullptr, std::memory_order_acquire);
+            if (!next) {
+                next = new Segment();
+            }
+            tail_->next.store(next, std::memory_order_release);
+            tail_ = next;
+            tailIndex_ = 0;
+        }
+
+        ::new (static_cast<void*>(tail_->slot(tailIndex_))) T(std::move(value));
+        tail_->written.store(++tailIndex_, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pass up to maxCount values to fn(T&) in push order, destroying each afterwards (consumer side)
+     *
+     * @return Number of values consumed
+     */
+    template<typename Fn>
+    std::size_t consume(Fn&& fn, std::size_t maxCount) {
+        std::size_t consumed = 0;
+        while (consumed < maxCount) {
+            const std::size_t available = head_->written.load(std::memory_order_acquire);
+            if (headIndex_ == available) {
+                Segment* next = available == SegmentSize ? head_->next.load(std::memory_order_acquire) : nullptr;
+                if (!next) {
+                    break;
+                }
+                recycle(std::exchange(head_, next));
+                headIndex_ = 0;
+                continue;
+            }
+
+            for (; headIndex_ < available && consumed < maxCount; ++headIndex_, ++consumed) {
+                T* value = head_->slot(headIndex_);
+                fn(*value);
+                value->~T();
+            }
+        }
+        return consumed;
+    }
+
+    /**
+     * @brief True if nothing is waiting to be consumed (consumer side)
+     */
+    bool empty() const noexcept {
+        const std::size_t available = head_->written.load(std::memory_order_acquire);
+        if (headIndex_ != available) {
+            return false;
+        }
+        const Segment* next = available == SegmentSize ? head_->next.load(std::memory_order_acquire) : nullptr;
+        return !next || next->written.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    struct Segment {
+        alignas(T) unsigned char storage[sizeof(T) * SegmentSize];
+        std::atomic<std::size_t> written{0};        // Constructed values, published by the producer
+        std::atomic<Segment*> next{nullptr};
+
+        T* slot(std::size_t index) noexcept {
+            return std::launder(reinterpret_cast<T*>(storage + sizeof(T) * index));
+        }
+    };
+
+    void recycle(Segment* segment) noexcept {
+        segment->written.store(0, std::memory_order_relaxed);
+        segment->next.store(nullptr, std::memory_order_relaxed);
+        delete spare_.exchange(segment, std::memory_order_acq_rel);
+    }
+
+    // Consumer side
+    alignas(64) Segment* head_;
+    std::size_t headIndex_ = 0;
+
+    // Producer side
+    alignas(64) Segment* tail_;
+    std::size_t tailIndex_ = 0;
+
+    alignas(64) std::atomic<Segment*> spare_{nullptr};      // Exhausted segment awaiting reuse
+};
+
+} // namespace detail
+} // namespace EventCore
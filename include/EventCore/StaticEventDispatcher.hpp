@@ -0,0 +1,383 @@
+#pragma once
+
+#include "Event.hpp"
+#include "Delegate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace EventCore {
+
+namespace detail {
+
+/**
+ * @brief Position of T in a type list (sizeof...(Ts) when absent)
+ */
+template<typename T, typename... Ts>
+consteval std::size_t static_type_index() {
+    constexpr bool matches[] = {std::is_same_v<T, Ts>..., false};
+    for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+        if (matches[i]) {
+            return i;
+        }
+    }
+    return sizeof...(Ts);
+}
+
+/**
+ * @brief True when no type appears twice in the list
+ */
+template<typename... Ts>
+consteval bool static_types_unique() {
+    constexpr std::size_t indices[] = {static_type_index<Ts, Ts...>()..., 0};
+    for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+        if (indices[i] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Dispatcher for a closed, compile-time set of event types
+ *
+ * Each event type in Events... maps to a fixed slot computed at compile
+ * time, so dispatch<EventT>() indexes an array directly: no EventTypeId
+ * hashing, no map probe and no epoch guard. Handlers bound with
+ * subscribe<&Listener::method>() compile the member call into the
+ * delegate's trampoline, leaving one inlinable indirect call per listener.
+ *
+ * The API mirrors EventDispatcher's subscribe/unsubscribe/dispatch, with the
+ * same priority ordering and weak_ptr lifetime tracking. Listeners may
+ * subscribe and unsubscribe from inside callbacks; such changes take effect
+ * once the outermost dispatch returns.
+ *
+ * Thread Safety: Not thread-safe; intended for a single simulation thread.
+ * Use EventDispatcher for cross-thread or open-ended event sets.
+ *
+ * Example:
+ * EventCore::StaticEventDispatcher<TickEvent, CollisionEvent> sim;
+ * sim.subscribe<&Physics::on_tick>(physics);
+ * sim.subscribe<CollisionEvent>(audio, &Audio::on_collision, EventPriority::Low);
+ * sim.dispatch(TickEvent{dt});
+ */
+template<typename... Events>
+class StaticEventDispatcher {
+    static_assert(sizeof...(Events) > 0, "StaticEventDispatcher needs at least one event type");
+    static_assert((std::is_base_of_v<Event, Events> && ...),
+                  "All event types must inherit from EventCore::Event");
+    static_assert(detail::static_types_unique<Events...>(),
+                  "Event types must not be repeated");
+
+public:
+    static constexpr std::size_t event_type_count = sizeof...(Events);
+
+    /**
+     * @brief Compile-time slot of an event type
+     */
+    template<typename EventT>
+    static constexpr std::size_t index_of() noexcept {
+        constexpr std::size_t index = detail::static_type_index<std::decay_t<EventT>, Events...>();
+        static_assert(index < sizeof...(Events), "EventT is not part of this StaticEventDispatcher");
+        return index;
+    }
+
+    StaticEventDispatcher() = default;
+
+    // Non-copyable, non-movable (listeners hold raw pointers into user objects)
+    StaticEventDispatcher(const StaticEventDispatcher&) = delete;
+    StaticEventDispatcher& operator=(const StaticEventDispatcher&) = delete;
+    StaticEventDispatcher(StaticEventDispatcher&&) = delete;
+    StaticEventDispatcher& operator=(StaticEventDispatcher&&) = delete;
+
+    /**
+     * @brief Subscribe a member function (runtime pointer) with weak_ptr lifetime
+     */
+    template<typename EventT, typename ListenerT, EventHandlerResult ResultT>
+    void subscribe(std::shared_ptr<ListenerT> listenerInstance,
+                   ResultT (ListenerT::*memberFunc)(const EventT&),
+                   EventPriority priority = EventPriority::Normal) {
+        ListenerT* rawPtr = listenerInstance.get();
+        insert_listener<EventT>(detail::Delegate::bind_member<std::decay_t<EventT>>(rawPtr, memberFunc),
+                                rawPtr, std::static_pointer_cast<void>(listenerInstance), priority, true);
+    }
+
+    /**
+     * @brief Subscribe a compile-time bound member function with weak_ptr lifetime
+     *
+     * The event type is deduced from the handler's signature.
+     */
+    template<auto MemberFunc>
+    void subscribe(std::shared_ptr<typename detail::member_handler_traits<decltype(MemberFunc)>::listener_type> listenerInstance,
+                   EventPriority priority = EventPriority::Normal) {
+        using EventT = typename detail::member_handler_traits<decltype(MemberFunc)>::event_type;
+
+        auto* rawPtr = listenerInstance.get();
+        insert_listener<EventT>(detail::Delegate::bind_method<MemberFunc>(rawPtr),
+                                rawPtr, std::static_pointer_cast<void>(listenerInstance), priority, true);
+    }
+
+    /**
+     * @brief Subscribe a member function (runtime pointer) with explicit lifetime
+     */
+    template<typename EventT, typename ListenerT, EventHandlerResult ResultT>
+    void subscribe_unowned(ListenerT* listenerInstance,
+                           ResultT (ListenerT::*memberFunc)(const EventT&),
+                           EventPriority priority = EventPriority::Normal) {
+        insert_listener<EventT>(detail::Delegate::bind_member<std::decay_t<EventT>>(listenerInstance, memberFunc),
+                                listenerInstance, {}, priority, false);
+    }
+
+    /**
+     * @brief Subscribe a compile-time bound member function with explicit lifetime
+     */
+    template<auto MemberFunc>
+    void subscribe_unowned(typename detail::member_handler_traits<decltype(MemberFunc)>::listener_type* listenerInstance,
+                           EventPriority priority = EventPriority::Normal) {
+        using EventT = typename detail::member_handler_traits<decltype(MemberFunc)>::event_type;
+
+        insert_listener<EventT>(detail::Delegate::bind_method<MemberFunc>(listenerInstance),
+                                listenerInstance, {}, priority, false);
+    }
+
+    /**
+     * @brief Unsubscribe a specific listener member function from an event type
+     *
+     * Removes every subscription of memberFunc on listenerInstance made with
+     * the runtime member pointer forms; other member functions of the same
+     * instance stay subscribed.
+     */
+    template<typename EventT, typename ListenerT, EventHandlerResult ResultT>
+    void unsubscribe(ListenerT* listenerInstance,
+                     ResultT (ListenerT::*memberFunc)(const EventT&)) {
+        remove_matching(index_of<EventT>(),
+                        detail::Delegate::bind_member<std::decay_t<EventT>>(listenerInstance, memberFunc));
+    }
+
+    /**
+     * @brief Unsubscribe a compile-time bound member function (subscribe<&Listener::method>())
+     */
+    template<auto MemberFunc>
+    void unsubscribe(typename detail::member_handler_traits<decltype(MemberFunc)>::listener_type* listenerInstance) {
+        using EventT = typename detail::member_handler_traits<decltype(MemberFunc)>::event_type;
+
+        remove_matching(index_of<EventT>(), detail::Delegate::bind_method<MemberFunc>(listenerInstance));
+    }
+
+    /**
+     * @brief Dispatch an event to every listener of its slot
+     *
+     * Stops at the first handler returning EventResult::Consumed.
+     *
+     * Performance: O(n) in the listeners of EventT, with no lookup cost
+     */
+    template<typename EventT>
+    EventResult dispatch(const EventT& event) {
+        auto& listenerList = lists_[index_of<EventT>()];
+        EventResult result = EventResult::Continue;
+
+        DispatchScope scope(*this);
+        // Safe to iterate: lists are never resized while a dispatch is running
+        for (const auto& listener : listenerList) {
+            if (listener.removed) {
+                continue;
+            }
+
+            bool consumed = false;
+            if (!listener.owned) {
+                consumed = listener.callback(&event);
+            } else if (auto lockedPtr = listener.weakInstancePtr.lock()) {
+                consumed = listener.callback(&event);
+            } else {
+                listener.removed = true;
+                needsCompaction_ = true;
+                --totalListeners_;
+            }
+
+            if (consumed) {
+                result = EventResult::Consumed;
+                break;
+            }
+        }
+
+        ++totalDispatches_;
+        return result;
+    }
+
+    /**
+     * @brief Remove listeners whose objects have been destroyed
+     *
+     * @return Number of expired listeners removed
+     */
+    std::size_t cleanup_expired_listeners() {
+        auto expired = [](const Listener& listener) {
+            return !listener.removed && listener.owned && listener.weakInstancePtr.expired();
+        };
+
+        std::size_t removedCount = 0;
+        for (std::size_t i = 0; i < sizeof...(Events); ++i) {
+            for (auto& listener : lists_[i]) {
+                if (expired(listener)) {
+                    listener.removed = true;
+                    ++removedCount;
+                }
+            }
+            removedCount += erase_pending_if(i, expired);
+        }
+        if (removedCount != 0) {
+            totalListeners_ -= removedCount;
+            needsCompaction_ = true;
+            compact_if_idle();
+        }
+        return removedCount;
+    }
+
+    /**
+     * @brief Get the number of listeners for a specific event type
+     */
+    template<typename EventT>
+    std::size_t get_listener_count() const {
+        const auto& listenerList = lists_[index_of<EventT>()];
+        return static_cast<std::size_t>(std::count_if(listenerList.begin(), listenerList.end(),
+            [](const Listener& listener) { return !listener.removed; })) +
+            pending_[index_of<EventT>()].size();
+    }
+
+    /**
+     * @brief Get total number of registered listeners
+     */
+    std::size_t get_total_listener_count() const noexcept {
+        return totalListeners_;
+    }
+
+    /**
+     * @brief Get total number of dispatched events
+     */
+    std::size_t get_total_dispatch_count() const noexcept {
+        return totalDispatches_;
+    }
+
+private:
+    struct Listener {
+        detail::Delegate callback;
+        void* instancePtr;
+        std::weak_ptr<void> weakInstancePtr;
+        EventPriority priority;
+        bool owned;
+        mutable bool removed;
+    };
+
+    using ListenerList = std::vector<Listener>;
+
+    /**
+     * @brief Tracks dispatch nesting; applies deferred changes on exit
+     */
+    struct DispatchScope {
+        StaticEventDispatcher& owner;
+
+        explicit DispatchScope(StaticEventDispatcher& dispatcher) : owner(dispatcher) {
+            ++owner.dispatchDepth_;
+        }
+        ~DispatchScope() {
+            --owner.dispatchDepth_;
+            owner.compact_if_idle();
+        }
+    };
+
+    template<typename EventT>
+    void insert_listener(detail::Delegate callback, void* instancePtr, std::weak_ptr<void> weakPtr,
+                         EventPriority priority, bool owned) {
+        static_assert(std::is_base_of_v<Event, std::decay_t<EventT>>,
+                      "EventT must inherit from EventCore::Event");
+
+        Listener listener{callback, instancePtr, std::move(weakPtr), priority, owned, false};
+        ++totalListeners_;
+
+        if (dispatchDepth_ != 0) {
+            // Never reallocate a list that is being iterated
+            pending_[index_of<EventT>()].push_back(std::move(listener));
+            needsCompaction_ = true;
+            return;
+        }
+        insert_sorted(lists_[index_of<EventT>()], std::move(listener));
+    }
+
+    /**
+     * @brief Remove the listeners of a slot bound to exactly this delegate
+     */
+    void remove_matching(std::size_t index, const detail::Delegate& callback) {
+        const std::size_t pendingCount = erase_pending_if(index,
+            [&callback](const Listener& listener) { return listener.callback == callback; });
+        totalListeners_ -= pendingCount;
+
+        for (auto& listener : lists_[index]) {
+            if (!listener.removed && listener.callback == callback) {
+                listener.removed = true;
+                needsCompaction_ = true;
+                --totalListeners_;
+            }
+        }
+        compact_if_idle();
+    }
+
+    /**
+     * @brief Drop not yet inserted listeners of a slot (pending_ is never iterated by dispatch)
+     *
+     * @return Number of listeners erased; the caller adjusts totalListeners_
+     */
+    template<typename Predicate>
+    std::size_t erase_pending_if(std::size_t index, Predicate&& predicate) {
+        auto& pending = pending_[index];
+        const auto newEnd = std::remove_if(pending.begin(), pending.end(), predicate);
+        const auto erasedCount = static_cast<std::size_t>(pending.end() - newEnd);
+        pending.erase(newEnd, pending.end());
+        return erasedCount;
+    }
+
+    static void insert_sorted(ListenerList& listenerList, Listener&& listener) {
+        // Higher priority first, FIFO among equals
+        auto insertPos = std::upper_bound(listenerList.begin(), listenerList.end(), listener.priority,
+            [](EventPriority prio, const Listener& other) {
+                return static_cast<int>(prio) > static_cast<int>(other.priority);
+            });
+        listenerList.insert(insertPos, std::move(listener));
+    }
+
+    /**
+     * @brief Apply deferred removals and insertions once no dispatch is running
+     */
+    void compact_if_idle() {
+        if (dispatchDepth_ != 0 || !needsCompaction_) {
+            return;
+        }
+        needsCompaction_ = false;
+
+        for (std::size_t i = 0; i < sizeof...(Events); ++i) {
+            auto& listenerList = lists_[i];
+            listenerList.erase(std::remove_if(listenerList.begin(), listenerList.end(),
+                [](const Listener& listener) { return listener.removed; }), listenerList.end());
+
+            for (auto& listener : pending_[i]) {
+                insert_sorted(listenerList, std::move(listener));
+            }
+            pending_[i].clear();
+        }
+    }
+
+    // One directly indexed listener list per event type
+    std::array<ListenerList, sizeof...(Events)> lists_;
+    std::array<ListenerList, sizeof...(Events)> pending_;
+
+    std::size_t totalListeners_ = 0;
+    std::size_t totalDispatches_ = 0;
+    std::size_t dispatchDepth_ = 0;
+    bool needsCompaction_ = false;
+};
+
+} // namespace EventCore
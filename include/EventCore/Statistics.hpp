@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Set to 0 (CMake: -DEVENTCORE_ENABLE_STATISTICS=OFF) to compile the
+// dispatch and queue counters out of the hot paths.
+#ifndef EVENTCORE_ENABLE_STATISTICS
+#define EVENTCORE_ENABLE_STATISTICS 1
+#endif
+
+namespace EventCore {
+
+/**
+ * @brief True when dispatch/queue statistics are compiled in
+ */
+inline constexpr bool kStatisticsEnabled = EVENTCORE_ENABLE_STATISTICS != 0;
+
+namespace detail {
+
+/**
+ * @brief Relaxed counters split across cache-line sized shards
+ *
+ * Each thread is assigned a shard on first use (round-robin), so threads
+ * counting concurrently touch different cache lines instead of bouncing a
+ * single shared atomic. Reads sum all shards. Counters are unsigned and
+ * wrap, so a value incremented on one shard and decremented on another
+ * still sums to the right total.
+ *
+ * Counter is an index into the shard, letting one shard line hold several
+ * related counters.
+ */
+template<std::size_t CounterCount>
+class ShardedCounters {
+public:
+    static constexpr std::size_t kShardCount = 16;
+
+    /**
+     * @brief Add to a counter on the calling thread's shard
+     *
+     * @return The shard's previous value of that counter
+     */
+    std::size_t add(std::size_t counter, std::size_t amount) noexcept {
+        return shards_[local_shard()].values[counter].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    void subtract(std::size_t counter, std::size_t amount) noexcept {
+        shards_[local_shard()].values[counter].fetch_sub(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sum of a counter over all shards (not a consistent snapshot)
+     */
+    std::size_t load(std::size_t counter) const noexcept {
+        std::size_t total = 0;
+        for (const Shard& shard : shards_) {
+            total += shard.values[counter].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::size_t> values[CounterCount] = {};
+    };
+
+    static std::size_t local_shard() noexcept {
+        static std::atomic<std::size_t> nextShard{0};
+        thread_local const std::size_t shard =
+            nextShard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+        return shard;
+    }
+
+    Shard shards_[kShardCount];
+};
+
+} // namespace detail
+} // namespace EventCore
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+namespace EventCore {
+
+class EventDispatcher;
+class LocalDispatcher;
+
+/**
+ * @brief Identifies one subscription for O(1) removal
+ * 
+ * Returned by every EventDispatcher subscribe call. A handle names a slot in
+ * its dispatcher's subscription table plus the slot's generation, so a stale
+ * handle (already unsubscribed, or expired and compacted away) is detected
+ * and ignored even after the slot has been reused. Handles are only
+ * meaningful to the dispatcher that issued them.
+ */
+class SubscriptionHandle {
+public:
+    SubscriptionHandle() = default;
+    
+    bool valid() const noexcept { return generation_ != 0; }
+    explicit operator bool() const noexcept { return valid(); }
+    
+    bool operator==(const SubscriptionHandle& other) const noexcept = default;
+    
+private:
+    friend class EventDispatcher;
+    friend class LocalDispatcher;
+    
+    SubscriptionHandle(std::uint32_t slot, std::uint32_t generation) noexcept
+        : slot_(slot), generation_(generation) {}
+    
+    std::uint32_t slot_ = 0;
+    std::uint32_t generation_ = 0;      // 0 = no subscription
+};
+
+} // namespace EventCore
@@ -0,0 +1,635 @@
+#pragma once
+
+#include "EventDispatcher.hpp"
+#include "SpscQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <concurrentqueue.h>
+
+namespace EventCore {
+
+class ThreadAffineDispatcher;
+
+namespace detail {
+
+/**
+ * @brief Per event type bitmask of the endpoints that have listeners for it
+ *
+ * Masks live in fixed-size chunks that are allocated on first use and never
+ * move, so enqueueing threads read a type's mask with two loads. Each
+ * endpoint only flips its own bit. Types beyond kChunkSize * kMaxChunks are
+ * never routed.
+ */
+class EndpointInterestTable {
+public:
+    static constexpr std::size_t kChunkSize = 256;
+    static constexpr std::size_t kMaxChunks = 4096;
+
+    EndpointInterestTable() : chunks_(std::make_unique<std::atomic<Chunk*>[]>(kMaxChunks)) {}
+
+    ~EndpointInterestTable() {
+        for (std::size_t chunk = 0; chunk < kMaxChunks; ++chunk) {
+            delete chunks_[chunk].load(std::memory_order_relaxed);
+        }
+    }
+
+    EndpointInterestTable(const EndpointInterestTable&) = delete;
+    EndpointInterestTable& operator=(const EndpointInterestTable&) = delete;
+
+    /**
+     * @brief Endpoints with listeners for a type (bit i = endpoint i)
+     */
+    std::uint64_t interested(EventTypeIndex index) const noexcept {
+        const std::size_t chunk = index / kChunkSize;
+        if (chunk >= kMaxChunks) {
+            return 0;
+        }
+        const Chunk* masks = chunks_[chunk].load(std::memory_order_acquire);
+        return masks ? masks->masks[index % kChunkSize].load(std::memory_order_acquire) : 0;
+    }
+
+    void set(EventTypeIndex index, std::size_t endpoint, bool interested) {
+        const std::size_t chunk = index / kChunkSize;
+        if (chunk >= kMaxChunks) {
+            return;
+        }
+
+        Chunk* masks = chunks_[chunk].load(std::memory_order_acquire);
+        if (!masks) {
+            // Endpoints subscribe concurrently; the loser of the race frees its chunk
+            auto created = std::make_unique<Chunk>();
+            if (chunks_[chunk].compare_exchange_strong(masks, created.get(), std::memory_order_acq_rel)) {
+                masks = created.release();
+            }
+        }
+
+        const std::uint64_t bit = std::uint64_t{1} << endpoint;
+        if (interested) {
+            masks->masks[index % kChunkSize].fetch_or(bit, std::memory_order_release);
+        } else {
+            masks->masks[index % kChunkSize].fetch_and(~bit, std::memory_order_release);
+        }
+    }
+
+private:
+    struct Chunk {
+        std::atomic<std::uint64_t> masks[kChunkSize]{};
+    };
+
+    std::unique_ptr<std::atomic<Chunk*>[]> chunks_;
+};
+
+} // namespace detail
+
+/**
+ * @brief One thread's endpoint of a ThreadAffineDispatcher
+ *
+ * Listeners subscribed here belong to the owning thread and only ever run
+ * on it. dispatch() calls them directly: the listener lists are plain
+ * vectors touched by no other thread, so there are no locks, atomics or
+ * epoch guards on the path. enqueue() delivers an event to every endpoint
+ * that has listeners for its type, copying it into one single-producer
+ * single-consumer mailbox per recipient; each recipient runs its listeners
+ * when its thread calls process_queued_events().
+ *
+ * Listeners may subscribe and unsubscribe from inside callbacks; such
+ * changes take effect once the outermost dispatch returns.
+ *
+ * Thread Safety: Every member must be called from the endpoint's owning
+ * thread. Other threads reach it only through ThreadAffineDispatcher::enqueue().
+ */
+class LocalDispatcher {
+public:
+    LocalDispatcher(const LocalDispatcher&) = delete;
+    LocalDispatcher& operator=(const LocalDispatcher&) = delete;
+
+    /**
+     * @brief Position of this endpoint in its group
+     */
+    std::size_t index() const noexcept { return index_; }
+
+    /**
+     * @brief Subscribe a member function with weak_ptr lifetime tracking
+     */
+    template<typename EventT, typename ListenerT, EventHandlerResult ResultT>
+    SubscriptionHandle subscribe(std::shared_ptr<ListenerT> listenerInstance,
+                                 ResultT (ListenerT::*memberFunc)(const EventT&),
+                                 EventPriority priority = EventPriority::Normal) {
+        using DecayedEventT = std::decay_t<EventT>;
+        static_assert(std::is_base_of_v<Event, DecayedEventT>,
+                      "EventT must inherit from EventCore::Event");
+
+        ListenerT* rawPtr = listenerInstance.get();
+        return insert_listener(get_event_type_index<DecayedEventT>(),
+                               detail::Delegate::bind_member<DecayedEventT>(rawPtr, memberFunc),
+                               std::static_pointer_cast<void>(listenerInstance), priority, true);
+    }
+
+    /**
+     * @brief Subscribe a member function with explicit (unowned) lifetime
+     */
+    template<typename EventT, typename ListenerT, EventHandlerResult ResultT>
+    SubscriptionHandle subscribe_unowned(ListenerT* listenerInstance,
+                                         ResultT (ListenerT::*memberFunc)(const EventT&),
+                                         EventPriority priority = EventPriority::Normal) {
+        using DecayedEventT = std::decay_t<EventT>;
+        static_assert(std::is_base_of_v<Event, DecayedEventT>,
+                      "EventT must inherit from EventCore::Event");
+
+        return insert_listener(get_event_type_index<DecayedEventT>(),
+                               detail::Delegate::bind_member<DecayedEventT>(listenerInstance, memberFunc),
+                               {}, priority, false);
+    }
+
+    /**
+     * @brief Subscribe a small trivially copyable callable (see EventDispatcher::subscribe)
+     */
+    template<typename EventT, typename CallableT>
+        requires std::invocable<const std::decay_t<CallableT>&, const std::decay_t<EventT>&>
+    SubscriptionHandle subscribe(CallableT&& callable, EventPriority priority = EventPriority::Normal) {
+        using DecayedEventT = std::decay_t<EventT>;
+        static_assert(std::is_base_of_v<Event, DecayedEventT>,
+                      "EventT must inherit from EventCore::Event");
+
+        return insert_listener(get_event_type_index<DecayedEventT>(),
+                               detail::Delegate::bind_callable<DecayedEventT>(std::forward<CallableT>(callable)),
+                               {}, priority, false);
+    }
+
+    /**
+     * @brief Remove the listener a handle refers to
+     *
+     * @return false if the handle is empty or already unsubscribed (handles are per endpoint)
+     */
+    bool unsubscribe(SubscriptionHandle handle) {
+        if (!handle.valid() || handle.slot_ >= slots_.size()) {
+            return false;
+        }
+        Slot& slot = slots_[handle.slot_];
+        if (slot.generation != handle.generation_ || !slot.live) {
+            return false;
+        }
+
+        for (auto* list : {&lists_[slot.typeIndex], &pending_[slot.typeIndex]}) {
+            for (auto& listener : *list) {
+                if (listener.slot == handle.slot_ && !listener.removed) {
+                    remove(listener);
+                }
+            }
+        }
+        compact_if_idle();
+        return true;
+    }
+
+    /**
+     * @brief Call this endpoint's listeners for the event immediately
+     *
+     * Stops at the first handler returning EventResult::Consumed. Listeners
+     * on other endpoints are not called; use enqueue() to reach them.
+     */
+    template<typename EventT>
+    EventResult dispatch(const EventT& event) {
+        return dispatch_type_erased(get_event_type_index<std::decay_t<EventT>>(), &event)
+            ? EventResult::Consumed : EventResult::Continue;
+    }
+
+    /**
+     * @brief Deliver an event to every endpoint with listeners for its type
+     *
+     * This endpoint is included when it has listeners of its own; its copy
+     * is queued locally rather than dispatched. With several recipients the
+     * event is copied for all but the last one, which receives it moved; a
+     * move-only event goes to the lowest-numbered interested endpoint only.
+     *
+     * @return Number of endpoints the event was queued for
+     */
+    template<typename EventT>
+    std::size_t enqueue(EventT&& event);
+
+    /**
+     * @brief Dispatch events queued for this endpoint
+     *
+     * Drains the local queue, the mailboxes from the other endpoints and
+     * the inbox fed by ThreadAffineDispatcher::enqueue(), in that order; each
+     * source is delivered in its own FIFO order. Events queued by the
+     * listeners themselves wait for the next call.
+     *
+     * @param maxEvents Upper bound on events processed (0 = everything queued)
+     * @return Number of events dispatched (0 when called from a listener)
+     */
+    std::size_t process_queued_events(std::size_t maxEvents = 0);
+
+    /**
+     * @brief Number of this endpoint's listeners for an event type
+     */
+    template<typename EventT>
+    std::size_t get_listener_count() const {
+        const EventTypeIndex typeIndex = get_event_type_index<std::decay_t<EventT>>();
+        return typeIndex < counts_.size() ? counts_[typeIndex] : 0;
+    }
+
+    std::size_t get_total_listener_count() const noexcept { return totalListeners_; }
+    std::size_t get_total_dispatch_count() const noexcept { return totalDispatches_; }
+
+private:
+    friend class ThreadAffineDispatcher;
+
+    struct Listener {
+        detail::Delegate callback;
+        std::weak_ptr<void> weakInstancePtr;
+        std::uint32_t slot;
+        EventPriority priority;
+        bool owned;
+        mutable bool removed;
+    };
+
+    struct Slot {
+        std::uint32_t generation = 0;
+        EventTypeIndex typeIndex = 0;
+        bool live = false;
+    };
+
+    using ListenerList = std::vector<Listener>;
+
+    /**
+     * @brief Tracks dispatch nesting; applies deferred changes on exit
+     */
+    struct DispatchScope {
+        LocalDispatcher& owner;
+
+        explicit DispatchScope(LocalDispatcher& dispatcher) : owner(dispatcher) {
+            ++owner.dispatchDepth_;
+        }
+        ~DispatchScope() {
+            --owner.dispatchDepth_;
+            owner.compact_if_idle();
+        }
+    };
+
+    LocalDispatcher(ThreadAffineDispatcher& group, std::size_t index) : group_(group), index_(index) {}
+
+    SubscriptionHandle insert_listener(EventTypeIndex typeIndex, detail::Delegate callback,
+                                       std::weak_ptr<void> weakPtr, EventPriority priority, bool owned);
+
+    bool dispatch_type_erased(EventTypeIndex typeIndex, const void* eventData) {
+        ++totalDispatches_;
+        if (typeIndex >= lists_.size()) {
+            return false;
+        }
+
+        DispatchScope scope(*this);
+        // Safe to iterate: lists are never resized while a dispatch is running
+        for (const auto& listener : lists_[typeIndex]) {
+            if (listener.removed) {
+                continue;
+            }
+
+            bool consumed = false;
+            if (!listener.owned) {
+                consumed = listener.callback(eventData);
+            } else if (auto lockedPtr = listener.weakInstancePtr.lock()) {
+                consumed = listener.callback(eventData);
+            } else {
+                remove(listener);
+            }
+
+            if (consumed) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void remove(const Listener& listener) {
+        listener.removed = true;
+        needsCompaction_ = true;
+        --totalListeners_;
+
+        Slot& slot = slots_[listener.slot];
+        slot.live = false;
+        freeSlots_.push_back(listener.slot);
+        if (--counts_[slot.typeIndex] == 0) {
+            set_interest(slot.typeIndex, false);
+        }
+    }
+
+    static void insert_sorted(ListenerList& listenerList, Listener&& listener) {
+        // Higher priority first, FIFO among equals
+        auto insertPos = std::upper_bound(listenerList.begin(), listenerList.end(), listener.priority,
+            [](EventPriority prio, const Listener& other) {
+                return static_cast<int>(prio) > static_cast<int>(other.priority);
+            });
+        listenerList.insert(insertPos, std::move(listener));
+    }
+
+    /**
+     * @brief Apply deferred removals and insertions once no dispatch is running
+     */
+    void compact_if_idle() {
+        if (dispatchDepth_ != 0 || !needsCompaction_) {
+            return;
+        }
+        needsCompaction_ = false;
+
+        for (std::size_t i = 0; i < lists_.size(); ++i) {
+            auto& listenerList = lists_[i];
+            listenerList.erase(std::remove_if(listenerList.begin(), listenerList.end(),
+                [](const Listener& listener) { return listener.removed; }), listenerList.end());
+
+            for (auto& listener : pending_[i]) {
+                if (!listener.removed) {
+                    insert_sorted(listenerList, std::move(listener));
+                }
+            }
+            pending_[i].clear();
+        }
+    }
+
+    void set_interest(EventTypeIndex typeIndex, bool interested);
+
+    ThreadAffineDispatcher& group_;
+    const std::size_t index_;
+
+    // Listener lists indexed by EventTypeIndex, grown on first subscription
+    std::vector<ListenerList> lists_;
+    std::vector<ListenerList> pending_;
+    std::vector<std::size_t> counts_;
+
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> freeSlots_;
+
+    // Events this endpoint queued for itself
+    std::vector<detail::QueuedEvent> localQueue_;
+    std::vector<detail::QueuedEvent> draining_;
+    std::vector<detail::QueuedEvent> inboxBatch_;
+
+    std::size_t totalListeners_ = 0;
+    std::size_t totalDispatches_ = 0;
+    std::size_t dispatchDepth_ = 0;
+    bool needsCompaction_ = false;
+    bool processing_ = false;
+};
+
+/**
+ * @brief Group of thread-confined dispatchers connected by SPSC mailboxes
+ *
+ * Each of the threadCount endpoints (see LocalDispatcher) is owned by one
+ * thread, which subscribes, dispatches and processes its queue through
+ * local(index). Immediate dispatch on an endpoint has no synchronization at
+ * all. Deferred events travel through an N x N grid of single-producer
+ * single-consumer mailboxes, one per ordered pair of endpoints, so an
+ * enqueue from an endpoint thread costs a copy and a release store per
+ * recipient, and never contends with another producer. Recipients are
+ * found through a per-type bitmask, so endpoints without listeners for a
+ * type are never sent it.
+ *
+ * Threads that are not endpoints use ThreadAffineDispatcher::enqueue(),
+ * which goes through a multi-producer inbox per endpoint instead.
+ *
+ * Routing is by exact event type: event_base hierarchies and keyed
+ * subscriptions are EventDispatcher features. Events enqueued before a
+ * listener subscribes on another endpoint may not reach it.
+ *
+ * Example:
+ * EventCore::ThreadAffineDispatcher group(workerCount);
+ * // on worker i:
+ * auto& local = group.local(i);
+ * local.subscribe<ChunkLoadedEvent>(mesher, &Mesher::on_chunk_loaded);
+ * while (running) {
+ *     local.enqueue(ChunkLoadedEvent{chunkId});    // reaches every interested worker
+ *     local.process_queued_events();
+ * }
+ */
+class ThreadAffineDispatcher {
+public:
+    // Interest masks are one 64-bit word per event type
+    static constexpr std::size_t kMaxThreads = 64;
+
+    /**
+     * @param threadCount Number of endpoints (clamped to [1, kMaxThreads])
+     */
+    explicit ThreadAffineDispatcher(std::size_t threadCount)
+        : threadCount_(std::clamp<std::size_t>(threadCount, 1, kMaxThreads)) {
+        endpoints_.reserve(threadCount_);
+        inboxes_.reserve(threadCount_);
+        for (std::size_t i = 0; i < threadCount_; ++i) {
+            endpoints_.emplace_back(new LocalDispatcher(*this, i));
+            inboxes_.push_back(std::make_unique<moodycamel::ConcurrentQueue<detail::QueuedEvent>>());
+        }
+
+        mailboxes_.resize(threadCount_ * threadCount_);
+        for (std::size_t to = 0; to < threadCount_; ++to) {
+            for (std::size_t from = 0; from < threadCount_; ++from) {
+                if (from != to) {
+                    mailboxes_[to * threadCount_ + from] = std::make_unique<Mailbox>();
+                }
+            }
+        }
+    }
+
+    ThreadAffineDispatcher(const ThreadAffineDispatcher&) = delete;
+    ThreadAffineDispatcher& operator=(const ThreadAffineDispatcher&) = delete;
+
+    std::size_t thread_count() const noexcept { return threadCount_; }
+
+    /**
+     * @brief Endpoint owned by thread index (index < thread_count())
+     */
+    LocalDispatcher& local(std::size_t index) noexcept { return *endpoints_[index]; }
+
+    /**
+     * @brief Deliver an event to every interested endpoint from any thread
+     *
+     * Endpoint threads should prefer LocalDispatcher::enqueue(), which
+     * avoids the shared inbox.
+     *
+     * @return Number of endpoints the event was queued for
+     */
+    template<typename EventT>
+    std::size_t enqueue(EventT&& event) {
+        using DecayedEventT = std::decay_t<EventT>;
+        return fan_out<DecayedEventT>(std::forward<EventT>(event),
+            [this](std::size_t to, detail::QueuedEvent&& queued) {
+                inboxes_[to]->enqueue(std::move(queued));
+            });
+    }
+
+    /**
+     * @brief Number of listeners for an event type across all endpoints
+     *
+     * Thread Safety: Call only while no endpoint is subscribing or unsubscribing.
+     */
+    template<typename EventT>
+    std::size_t get_listener_count() const {
+        std::size_t count = 0;
+        for (const auto& endpoint : endpoints_) {
+            count += endpoint->get_listener_count<EventT>();
+        }
+        return count;
+    }
+
+private:
+    friend class LocalDispatcher;
+
+    // Small segments: the grid holds threadCount^2 mailboxes
+    using Mailbox = detail::SpscQueue<detail::QueuedEvent, 64>;
+
+    Mailbox& mailbox(std::size_t from, std::size_t to) noexcept {
+        return *mailboxes_[to * threadCount_ + from];
+    }
+
+    /**
+     * @brief Hand one queued copy of the event to each interested endpoint
+     */
+    template<typename EventT, typename Arg, typename Deliver>
+    std::size_t fan_out(Arg&& event, Deliver&& deliver) {
+        static_assert(std::is_base_of_v<Event, EventT>,
+                      "EventT must inherit from EventCore::Event");
+
+        std::uint64_t recipients = interest_.interested(get_event_type_index<EventT>());
+        if constexpr (!std::is_copy_constructible_v<EventT>) {
+            // A move-only event can only reach one endpoint: the lowest interested one
+            recipients &= ~recipients + 1;
+        }
+        const std::size_t count = static_cast<std::size_t>(std::popcount(recipients));
+
+        while (recipients != 0) {
+            const std::size_t to = static_cast<std::size_t>(std::countr_zero(recipients));
+            recipients &= recipients - 1;
+            if (recipients != 0) {
+                if constexpr (std::is_copy_constructible_v<EventT>) {
+                    deliver(to, detail::QueuedEvent::make<EventT>(std::as_const(event)));
+                }
+            } else {
+                deliver(to, detail::QueuedEvent::make<EventT>(std::forward<Arg>(event)));
+            }
+        }
+        return count;
+    }
+
+    const std::size_t threadCount_;
+    std::vector<std::unique_ptr<LocalDispatcher>> endpoints_;
+
+    // mailboxes_[to * threadCount_ + from]; the diagonal is unused (local queues)
+    std::vector<std::unique_ptr<Mailbox>> mailboxes_;
+    std::vector<std::unique_ptr<moodycamel::ConcurrentQueue<detail::QueuedEvent>>> inboxes_;
+
+    detail::EndpointInterestTable interest_;
+};
+
+inline SubscriptionHandle LocalDispatcher::insert_listener(EventTypeIndex typeIndex, detail::Delegate callback,
+                                                           std::weak_ptr<void> weakPtr, EventPriority priority,
+                                                           bool owned) {
+    if (typeIndex >= lists_.size()) {
+        lists_.resize(typeIndex + 1);
+        pending_.resize(typeIndex + 1);
+        counts_.resize(typeIndex + 1);
+    }
+
+    std::uint32_t slotIndex;
+    if (!freeSlots_.empty()) {
+        slotIndex = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slotIndex = static_cast<std::uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    Slot& slot = slots_[slotIndex];
+    slot.generation = slot.generation + 1 == 0 ? 1 : slot.generation + 1;
+    slot.typeIndex = typeIndex;
+    slot.live = true;
+
+    Listener listener{callback, std::move(weakPtr), slotIndex, priority, owned, false};
+    ++totalListeners_;
+    if (counts_[typeIndex]++ == 0) {
+        set_interest(typeIndex, true);
+    }
+
+    if (dispatchDepth_ != 0) {
+        // Never reallocate a list that is being iterated
+        pending_[typeIndex].push_back(std::move(listener));
+        needsCompaction_ = true;
+    } else {
+        insert_sorted(lists_[typeIndex], std::move(listener));
+    }
+    return SubscriptionHandle(slotIndex, slot.generation);
+}
+
+inline void LocalDispatcher::set_interest(EventTypeIndex typeIndex, bool interested) {
+    group_.interest_.set(typeIndex, index_, interested);
+}
+
+template<typename EventT>
+std::size_t LocalDispatcher::enqueue(EventT&& event) {
+    using DecayedEventT = std::decay_t<EventT>;
+    return group_.fan_out<DecayedEventT>(std::forward<EventT>(event),
+        [this](std::size_t to, detail::QueuedEvent&& queued) {
+            if (to == index_) {
+                localQueue_.push_back(std::move(queued));
+            } else {
+                group_.mailbox(index_, to).push(std::move(queued));
+            }
+        });
+}
+
+inline std::size_t LocalDispatcher::process_queued_events(std::size_t maxEvents) {
+    if (processing_) {
+        return 0;
+    }
+    processing_ = true;
+
+    std::size_t budget = maxEvents == 0 ? ~std::size_t{0} : maxEvents;
+    std::size_t processed = 0;
+    auto dispatchQueued = [this, &processed](detail::QueuedEvent& queued) {
+        dispatch_type_erased(queued.type_index(), queued.data());
+        ++processed;
+    };
+
+    // Swap out the local queue so events queued by listeners wait for the next call
+    draining_.swap(localQueue_);
+    const std::size_t localCount = std::min(draining_.size(), budget);
+    for (std::size_t i = 0; i < localCount; ++i) {
+        dispatchQueued(draining_[i]);
+    }
+    if (localCount < draining_.size()) {
+        // Out of budget: put the rest back ahead of anything queued meanwhile
+        localQueue_.insert(localQueue_.begin(), std::make_move_iterator(draining_.begin() + localCount),
+                           std::make_move_iterator(draining_.end()));
+    }
+    draining_.clear();
+    budget -= localCount;
+
+    for (std::size_t from = 0; from < group_.threadCount_ && budget != 0; ++from) {
+        if (from != index_) {
+            budget -= group_.mailbox(from, index_).consume(dispatchQueued, budget);
+        }
+    }
+
+    auto& inbox = *group_.inboxes_[index_];
+    while (budget != 0) {
+        inboxBatch_.resize(std::min<std::size_t>(budget, 64));
+        const std::size_t count = inbox.try_dequeue_bulk(inboxBatch_.begin(), inboxBatch_.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            dispatchQueued(inboxBatch_[i]);
+        }
+        inboxBatch_.clear();
+        budget -= count;
+        if (count == 0) {
+            break;
+        }
+    }
+
+    processing_ = false;
+    return processed;
+}
+
+} // namespace EventCore
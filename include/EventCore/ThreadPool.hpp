@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EventCore {
+
+/**
+ * @brief Small work-stealing thread pool used for parallel event processing
+ *
+ * Each worker owns a task deque. Workers pop their own tasks LIFO (hot in
+ * cache) and steal from the front of other workers' deques when idle.
+ * Tasks submitted from outside the pool are distributed round-robin.
+ *
+ * Threads waiting on submitted work should call try_run_one() in their wait
+ * loop, which lets a waiting caller (including a pool worker) help drain the
+ * pool instead of blocking it.
+ *
+ * Example:
+ * EventCore::ThreadPool pool(4);
+ * dispatcher.process_queued_events_parallel(pool);
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Start a pool with the given number of worker threads
+     *
+     * @param threadCount Worker count (0 = hardware concurrency, at least 1)
+     */
+    explicit ThreadPool(std::size_t threadCount = 0) {
+        if (threadCount == 0) {
+            threadCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        queues_.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        workers_.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            workers_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    /**
+     * @brief Stop all workers after the queued tasks have run
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(sleepMutex_);
+            stopping_ = true;
+        }
+        wakeCondition_.notify_all();
+
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /**
+     * @brief Queue a task for execution on a worker
+     *
+     * Called from a worker, the task goes to that worker's own deque.
+     */
+    void submit(Task task) {
+        std::size_t queueIndex = current_worker_index();
+        if (queueIndex == kNotAWorker || current_pool() != this) {
+            queueIndex = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        }
+
+        // Count first so poppers never decrement below zero
+        pendingTasks_.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard lock(queues_[queueIndex]->mutex);
+            queues_[queueIndex]->tasks.push_back(std::move(task));
+        }
+
+        {
+            // Pairs with the predicate check in worker_loop to avoid lost wakeups
+            std::lock_guard lock(sleepMutex_);
+        }
+        wakeCondition_.notify_one();
+    }
+
+    /**
+     * @brief Run one pending task on the calling thread, if any
+     *
+     * @return true if a task was executed
+     */
+    bool try_run_one() {
+        std::size_t home = current_pool() == this ? current_worker_index() : 0;
+        if (home == kNotAWorker) {
+            home = 0;
+        }
+
+        Task task;
+        if (!try_pop(home, task)) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    /**
+     * @brief Number of worker threads
+     */
+    std::size_t thread_count() const noexcept {
+        return workers_.size();
+    }
+
+private:
+    static constexpr std::size_t kNotAWorker = ~std::size_t{0};
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    static std::size_t& current_worker_index() noexcept {
+        thread_local std::size_t index = kNotAWorker;
+        return index;
+    }
+
+    static ThreadPool*& current_pool() noexcept {
+        thread_local ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    /**
+     * @brief Pop from the home deque (back) or steal from the others (front)
+     */
+    bool try_pop(std::size_t home, Task& task) {
+        if (pendingTasks_.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+
+        {
+            WorkerQueue& own = *queues_[home];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                pendingTasks_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+            WorkerQueue& victim = *queues_[(home + offset) % queues_.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                pendingTasks_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void worker_loop(std::size_t index) {
+        current_worker_index() = index;
+        current_pool() = this;
+
+        Task task;
+        for (;;) {
+            if (try_pop(index, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock lock(sleepMutex_);
+            wakeCondition_.wait(lock, [this] {
+                return stopping_ || pendingTasks_.load(std::memory_order_acquire) != 0;
+            });
+            if (stopping_ && pendingTasks_.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> pendingTasks_{0};
+    std::atomic<std::size_t> nextQueue_{0};
+
+    std::mutex sleepMutex_;
+    std::condition_variable wakeCondition_;
+    bool stopping_ = false;
+};
+
+} // namespace EventCore
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace EventCore {
+namespace detail {
+
+/**
+ * @brief Hierarchical timing wheel over integer ticks
+ *
+ * Four levels of 64 slots cover 2^24 ticks ahead of the current tick; an
+ * entry sits on the level of the highest 6-bit group in which its deadline
+ * differs from the next unexpired tick and moves down a level each time its
+ * slot comes around. Inserting is O(1) and an entry is moved at most once
+ * per level before it expires. Deadlines beyond the wheel's span wait in an
+ * overflow list that is re-examined once per full rotation.
+ *
+ * Per-level occupancy bitmaps let advance() skip empty slots, and slot
+ * vectors keep their capacity, so a warmed-up wheel does not allocate.
+ *
+ * Not thread-safe; the owner serializes access.
+ */
+template<typename T>
+class TimerWheel {
+public:
+    static constexpr std::size_t kLevelBits = 6;
+    static constexpr std::size_t kSlotCount = std::size_t{1} << kLevelBits;
+    static constexpr std::size_t kLevelCount = 4;
+    static constexpr std::uint64_t kSlotMask = kSlotCount - 1;
+
+    /**
+     * @brief Schedule a value for a tick (past ticks expire on the next advance)
+     */
+    void insert(std::uint64_t deadlineTick, T&& value) {
+        place(Entry{std::max(deadlineTick, nextTick_), std::move(value)});
+        ++size_;
+    }
+
+    /**
+     * @brief Expire every entry due at or before nowTick
+     *
+     * @param onExpired Called with each expired value (T&&), in tick order
+     */
+    template<typename OnExpired>
+    void advance(std::uint64_t nowTick, OnExpired&& onExpired) {
+        while (nextTick_ <= nowTick) {
+            if (size_ == 0) {
+                nextTick_ = nowTick + 1;
+                return;
+            }
+            if ((nextTick_ & kSlotMask) == 0) {
+                cascade();
+            }
+
+            // Expire the occupied level-0 slots up to the end of this rotation
+            const std::uint64_t lastTick = std::min(nowTick, nextTick_ | kSlotMask);
+            const std::size_t firstSlot = nextTick_ & kSlotMask;
+            const std::size_t lastSlot = lastTick & kSlotMask;
+            std::uint64_t due = occupied_[0] & (~std::uint64_t{0} >> (kSlotMask - lastSlot)) &
+                                (~std::uint64_t{0} << firstSlot);
+            while (due != 0) {
+                const auto slot = static_cast<std::size_t>(std::countr_zero(due));
+                due &= due - 1;
+
+                std::vector<Entry>& entries = slots_[0][slot];
+                for (Entry& entry : entries) {
+                    onExpired(std::move(entry.value));
+                }
+                size_ -= entries.size();
+                entries.clear();
+                occupied_[0] &= ~(std::uint64_t{1} << slot);
+            }
+            nextTick_ = lastTick + 1;
+        }
+    }
+
+    /**
+     * @brief First tick that has not been expired yet
+     */
+    std::uint64_t next_tick() const noexcept { return nextTick_; }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+private:
+    struct Entry {
+        std::uint64_t deadline;
+        T value;
+    };
+
+    void place(Entry&& entry) {
+        const std::uint64_t differing = entry.deadline ^ nextTick_;
+        const std::size_t level = differing == 0 ? 0 : (std::bit_width(differing) - 1) / kLevelBits;
+        if (level >= kLevelCount) {
+            overflow_.push_back(std::move(entry));
+            return;
+        }
+
+        const std::size_t slot = (entry.deadline >> (kLevelBits * level)) & kSlotMask;
+        slots_[level][slot].push_back(std::move(entry));
+        occupied_[level] |= std::uint64_t{1} << slot;
+    }
+
+    /**
+     * @brief Move the slots starting at nextTick_ down a level (nextTick_ is a multiple of kSlotCount)
+     */
+    void cascade() {
+        std::size_t topLevel = 1;
+        while (topLevel < kLevelCount &&
+               (nextTick_ & ((std::uint64_t{1} << (kLevelBits * (topLevel + 1))) - 1)) == 0) {
+            ++topLevel;
+        }
+
+        if (topLevel == kLevelCount) {
+            redistribute(overflow_);
+            topLevel = kLevelCount - 1;
+        }
+        for (std::size_t level = topLevel; level >= 1; --level) {
+            const std::size_t slot = (nextTick_ >> (kLevelBits * level)) & kSlotMask;
+            occupied_[level] &= ~(std::uint64_t{1} << slot);
+            redistribute(slots_[level][slot]);
+        }
+    }
+
+    void redistribute(std::vector<Entry>& entries) {
+        if (entries.empty()) {
+            return;
+        }
+        scratch_.swap(entries);
+        for (Entry& entry : scratch_) {
+            place(std::move(entry));
+        }
+        scratch_.clear();
+    }
+
+    std::array<std::array<std::vector<Entry>, kSlotCount>, kLevelCount> slots_;
+    std::array<std::uint64_t, kLevelCount> occupied_{};     // Bit per non-empty slot
+    std::vector<Entry> overflow_;                           // Deadlines beyond the top level
+    std::vector<Entry> scratch_;
+    std::uint64_t nextTick_ = 0;
+    std::size_t size_ = 0;
+};
+
+} // namespace detail
+} // namespace EventCore
@@ -0,0 +1,23 @@
+#include "EventCore/EpochReclaimer.hpp"
+
+#include <thread>
+
+namespace EventCore {
+namespace detail {
+
+void EpochDomain::synchronize() {
+    const std::uint64_t epoch = globalEpoch_.fetch_add(1, std::memory_order_seq_cst);
+    const ThreadRecord* self = &local_record();
+    for (ThreadRecord* record = records_.load(std::memory_order_acquire); record; record = record->next) {
+        if (record == self) {
+            continue;
+        }
+        // Sections entered after the increment announce a later epoch (idle is the largest)
+        while (record->epoch.load(std::memory_order_seq_cst) <= epoch) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace detail
+} // namespace EventCore
@@ -1,11 +1,1364 @@
 #include "EventCore/EventDispatcher.hpp"
+#include "EventCore/ThreadPool.hpp"
+
+#include <condition_variable>
+#include <ostream>
 
 namespace EventCore {
 
-// Note: Most EventDispatcher methods are implemented in the header due to templates.
-// This source file is provided for potential future non-templated implementations
-// and to maintain proper project structure.
+// The type-erased core of EventDispatcher: everything below works on
+// EventTypeIndex and const void* event data, so it is compiled once here
+// instead of in every translation unit that includes the header. The
+// templated subscribe/dispatch/enqueue shims in the header reduce each call
+// to one of these entry points.
+
+// Lifetime and public entry points
+
+struct EventDispatcher::ParkState {
+    std::mutex mutex;
+    std::condition_variable signal;
+    std::uint64_t wakeSequence = 0;             // Guarded by mutex: bumped by every wakeup
+};
+
+EventDispatcher::EventDispatcher()
+    : park_(std::make_unique<ParkState>()) {}
+
+EventDispatcher::EventDispatcher(CleanupPolicy cleanupPolicy)
+    : park_(std::make_unique<ParkState>()), cleanupPolicy_(cleanupPolicy) {}
+
+EventDispatcher::EventDispatcher(const DispatcherConfig& config)
+    : laneBudgets_(config.laneBudgets), queuePolicy_(config.queue), delayedEvents_(config.timerResolution),
+      waitStrategy_(config.wait), park_(std::make_unique<ParkState>()), cleanupPolicy_(config.cleanup) {}
+
+EventDispatcher::~EventDispatcher() {
+    for (auto& channel : channels_) {
+        delete channel->snapshot.load(std::memory_order_relaxed);
+        delete channel->keyed.load(std::memory_order_relaxed);
+    }
+    delete channelTable_.load(std::memory_order_relaxed);
+}
+
+bool EventDispatcher::unsubscribe(SubscriptionHandle handle) {
+    std::lock_guard lock(writeMutex_);
+
+    if (!handle.valid() || handle.slot_ >= slots_.size()) {
+        return false;
+    }
+    const SubscriptionSlot& slot = slots_[handle.slot_];
+    if (!slot.active || slot.generation != handle.generation_) {
+        return false;
+    }
+
+    remove_subscription_locked(handle.slot_);
+    return true;
+}
+
+bool EventDispatcher::unsubscribe_and_wait(SubscriptionHandle handle) {
+    if (!unsubscribe(handle)) {
+        return false;
+    }
+    detail::EpochDomain::instance().synchronize();
+    return true;
+}
+
+std::size_t EventDispatcher::process_queued_events(std::size_t maxEvents, DeferredOrder order) {
+    return drain_queue(maxEvents, order, [this](std::size_t lane, detail::QueuedEvent* batch, std::size_t limit) {
+        return eventQueues_[lane].try_dequeue_bulk(batch, limit);
+    });
+}
+
+std::size_t EventDispatcher::process_queued_events(Consumer& consumer, std::size_t maxEvents, DeferredOrder order) {
+    return drain_queue(maxEvents, order,
+                       [this, &consumer](std::size_t lane, detail::QueuedEvent* batch, std::size_t limit) {
+        return eventQueues_[lane].try_dequeue_bulk(consumer.tokens_[lane], batch, limit);
+    });
+}
+
+std::size_t EventDispatcher::wait_and_process(std::chrono::nanoseconds timeout, std::size_t maxEvents,
+                                              DeferredOrder order) {
+    return wait_and_drain(timeout, [this, maxEvents, order] {
+        return process_queued_events(maxEvents, order);
+    });
+}
+
+std::size_t EventDispatcher::wait_and_process(Consumer& consumer, std::chrono::nanoseconds timeout,
+                                              std::size_t maxEvents, DeferredOrder order) {
+    return wait_and_drain(timeout, [this, &consumer, maxEvents, order] {
+        return process_queued_events(consumer, maxEvents, order);
+    });
+}
+
+void EventDispatcher::wake_waiting_consumers() {
+    {
+        std::lock_guard lock(park_->mutex);
+        ++park_->wakeSequence;
+        interruptSequence_.fetch_add(1, std::memory_order_relaxed);
+    }
+    park_->signal.notify_all();
+}
+
+std::size_t EventDispatcher::process_queued_events_parallel(ThreadPool& pool, std::size_t maxEvents,
+                                                            ParallelOrder order) {
+    // Drain into a contiguous buffer first: due scheduled events, the queue, coalesced overflow events
+    std::vector<detail::QueuedEvent> events;
+    auto drainInto = [&events, maxEvents](auto&& dequeueBulk) {
+        while (maxEvents == 0 || events.size() < maxEvents) {
+            std::size_t batchLimit = kDequeueBatchSize;
+            if (maxEvents != 0) {
+                batchLimit = std::min(batchLimit, maxEvents - events.size());
+            }
+
+            const std::size_t offset = events.size();
+            events.resize(offset + batchLimit);
+            const std::size_t count = dequeueBulk(events.data() + offset, batchLimit);
+            events.resize(offset + count);
+            if (count == 0) {
+                break;
+            }
+        }
+    };
+    collect_due_events();
+    drainInto([this](detail::QueuedEvent* out, std::size_t limit) {
+        return delayedEvents_.take_ready(out, limit);
+    });
+    const std::size_t dueCount = events.size();
+    for (std::size_t lane = kDeferredLaneCount; lane-- > 0;) {
+        std::size_t laneRemaining = lane_event_budget(lane);
+        drainInto([this, lane, &laneRemaining](detail::QueuedEvent* out, std::size_t limit) {
+            const std::size_t count = eventQueues_[lane].try_dequeue_bulk(out, std::min(limit, laneRemaining));
+            laneRemaining -= count;
+            return count;
+        });
+    }
+    release_slots(events.size() - dueCount);
+    drainInto([this](detail::QueuedEvent* out, std::size_t limit) {
+        return overflowTable_.take(out, limit);
+    });
+
+    count_dequeued(events.size() - dueCount);
+    events.resize(resolve_placeholders(events.data(), events.size()));
+    if (events.empty()) {
+        return 0;
+    }
+    record_queue_dwell(events.data(), events.size());
+
+    // Partition into ordering groups, preserving enqueue order inside each.
+    // Distinct keys that collide share a group: less parallelism, same guarantees.
+    robin_hood::unordered_flat_map<std::uint64_t, std::size_t> groupIndex;
+    std::vector<std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        std::uint64_t groupKey = events[i].type_index();
+        std::uint64_t eventKey = 0;
+        if (order == ParallelOrder::PerKey && events[i].key(eventKey)) {
+            groupKey = (eventKey + 1) * 0x9E3779B97F4A7C15ULL;
+        }
+
+        auto [it, inserted] = groupIndex.emplace(groupKey, groups.size());
+        if (inserted) {
+            groups.emplace_back();
+        }
+        groups[it->second].push_back(i);
+    }
+
+    auto runGroup = [this, &events](const std::vector<std::size_t>& group) {
+        DrainScope drainScope(this);
+        for (std::size_t index : group) {
+            dispatch_type_erased_with(events[index].type_index(), events[index].data(),
+                [this](const ListenerSnapshot& snapshot, std::size_t index, const void* eventData) {
+                    return invoke_on_strand(snapshot, index, eventData);
+                });
+        }
+    };
+
+    if (groups.size() == 1) {
+        runGroup(groups.front());
+        return events.size();
+    }
+
+    std::atomic<std::size_t> remainingGroups{groups.size()};
+    for (const auto& group : groups) {
+        pool.submit([&runGroup, &group, &remainingGroups] {
+            runGroup(group);
+            remainingGroups.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+
+    // Help instead of blocking, so this also works from inside a pool worker
+    while (remainingGroups.load(std::memory_order_acquire) != 0) {
+        if (!pool.try_run_one()) {
+            std::this_thread::yield();
+        }
+    }
+
+    return events.size();
+}
+
+std::size_t EventDispatcher::cleanup_expired_listeners() {
+    std::lock_guard lock(writeMutex_);
+
+    std::size_t removedCount = 0;
+    for (auto& channel : channels_) {
+        if (channel->dirty.exchange(false, std::memory_order_acq_rel)) {
+            dirtyChannels_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        removedCount += cleanup_channel_locked(*channel);
+    }
+
+    totalListeners_.fetch_sub(removedCount, std::memory_order_relaxed);
+    return removedCount;
+}
+
+std::size_t EventDispatcher::compact_expired_listeners(std::size_t channelBudget) {
+    if (dirtyChannels_.load(std::memory_order_relaxed) == 0) {
+        return 0;
+    }
+
+    std::lock_guard lock(writeMutex_);
+    return compact_dirty_channels_locked(channelBudget);
+}
+
+std::size_t EventDispatcher::get_event_type_count() const {
+    std::lock_guard lock(writeMutex_);
+    return static_cast<std::size_t>(std::count_if(channels_.begin(), channels_.end(),
+        [](const std::unique_ptr<detail::ListenerChannel>& channel) {
+            if (channel->keyedParent) {
+                return false;   // Counted through its type channel
+            }
+            const ListenerSnapshot* snapshot = channel->snapshot.load(std::memory_order_relaxed);
+            return (snapshot && snapshot->live_count() != 0) ||
+                   channel->keyed.load(std::memory_order_relaxed) != nullptr;
+        }));
+}
+
+InstrumentationSnapshot EventDispatcher::instrumentation_snapshot() const {
+    InstrumentationSnapshot result;
+#if EVENTCORE_ENABLE_INSTRUMENTATION
+    std::lock_guard lock(writeMutex_);
+    const ChannelTable* table = channelTable_.load(std::memory_order_relaxed);
+    if (!table) {
+        return result;
+    }
+
+    for (std::size_t index = 0; index < table->size(); ++index) {
+        const detail::ListenerChannel* channel = (*table)[index];
+        if (!channel) {
+            continue;
+        }
+
+        EventTypeMetrics& metrics = result.eventTypes.emplace_back();
+        metrics.typeId = detail::EventTypeRegistry::type_id(static_cast<EventTypeIndex>(index));
+        metrics.dispatchCount = channel->recorder.dispatches.load(std::memory_order_relaxed);
+        metrics.queueDwell = channel->recorder.queueDwell.snapshot();
+
+        auto addListeners = [&](const ListenerSnapshot* snapshot) {
+            if (!snapshot) {
+                return;
+            }
+            snapshot->for_each([&](std::size_t i) {
+                if (snapshot->removed(i) || snapshot->inherited(i)) {
+                    return;
+                }
+                const std::uint32_t slotId = snapshot->slot(i);
+                ListenerMetrics& listener = metrics.listeners.emplace_back();
+                listener.handle = SubscriptionHandle(slotId, slots_[slotId].generation);
+                listener.instance = snapshot->instance(i);
+                listener.priority = static_cast<EventPriority>(snapshot->flags(i).priority);
+                if (const detail::LatencyRecorder* recorder = listenerRecorders_.find(slotId)) {
+                    listener.callbackTime = recorder->snapshot();
+                }
+            });
+        };
+        addListeners(channel->snapshot.load(std::memory_order_relaxed));
+        if (const detail::KeyedChannelIndex* keyed = channel->keyed.load(std::memory_order_relaxed)) {
+            keyed->for_each([&](std::uint64_t, const detail::ListenerChannel* keyedChannel) {
+                addListeners(keyedChannel->snapshot.load(std::memory_order_relaxed));
+            });
+        }
+    }
+#endif
+    return result;
+}
+
+void EventDispatcher::reset_instrumentation() {
+#if EVENTCORE_ENABLE_INSTRUMENTATION
+    std::lock_guard lock(writeMutex_);
+    for (auto& channel : channels_) {
+        channel->recorder.reset();
+    }
+    for (std::uint32_t slotId = 0; slotId < slots_.size(); ++slotId) {
+        if (detail::LatencyRecorder* recorder = listenerRecorders_.find(slotId)) {
+            recorder->reset();
+        }
+    }
+#endif
+}
+
+// Dispatch
+
+template<typename Fn>
+auto EventDispatcher::timed_callback(const ListenerSnapshot& snapshot, std::size_t index, Fn&& fn) {
+    const std::uint64_t start = detail::instrumentation_clock();
+    auto result = fn();
+#if EVENTCORE_ENABLE_INSTRUMENTATION
+    if (detail::LatencyRecorder* recorder = listenerRecorders_.find(snapshot.slot(index))) {
+        recorder->record(detail::instrumentation_clock() - start);
+    }
+#else
+    (void)snapshot;
+    (void)index;
+    (void)start;
+#endif
+    return result;
+}
+
+EventResult EventDispatcher::dispatch_type_erased(EventTypeIndex eventIndex, const void* eventData) {
+    return dispatch_type_erased_with(eventIndex, eventData, DirectInvoke{});
+}
+
+void EventDispatcher::dispatch_batch_type_erased(EventTypeIndex eventIndex, const void* events, std::size_t count,
+                                                 std::size_t stride) {
+    const auto* bytes = static_cast<const std::byte*>(events);
+
+    detail::ListenerChannel* channel = nullptr;
+    bool needsCleanup = false;
+
+    {
+        detail::EpochGuard guard;
+
+        const ListenerSnapshot* snapshot = resolve_listeners(eventIndex, channel);
+        const bool keyedListeners = channel && channel->keyed.load(std::memory_order_seq_cst);
+        if (!snapshot && !keyedListeners && !(channel && has_waiters(*channel))) {
+            return;
+        }
+
+        if (!snapshot || keyedListeners || snapshot->has_consumers()) {
+            // Event-major, so a consumed event skips the remaining listeners and keyed
+            // listeners (looked up per event) interleave with the unkeyed ones by priority
+            for (std::size_t e = 0; e < count; ++e) {
+                needsCleanup |= invoke_routed(*channel, snapshot, bytes + e * stride).sawExpired;
+            }
+        } else {
+            const detail::EventSpan eventSpan{events, count};
+            snapshot->for_each([&](std::size_t i) {
+                if (snapshot->removed(i)) {
+                    return;
+                }
+
+                const ListenerSnapshot::Flags flags = snapshot->flags(i);
+                std::shared_ptr<void> lockedPtr;
+                if (flags.owned) {
+                    lockedPtr = snapshot->lifetime(i).lock();
+                    if (!lockedPtr) {
+                        needsCleanup = true;
+                        return;
+                    }
+                }
+
+                const detail::Delegate& callback = snapshot->callback(i);
+                if (instrumenting()) {
+                    if (flags.batched) {
+                        timed_callback(*snapshot, i, [&] { return callback(&eventSpan); });
+                    } else {
+                        for (std::size_t e = 0; e < count; ++e) {
+                            const void* event = bytes + e * stride;
+                            timed_callback(*snapshot, i, [&] { return callback(snapshot->event_for(i, event)); });
+                        }
+                    }
+                } else if (flags.batched) {
+                    callback(&eventSpan);
+                } else {
+                    for (std::size_t e = 0; e < count; ++e) {
+                        callback(snapshot->event_for(i, bytes + e * stride));
+                    }
+                }
+            });
+        }
+    }
+
+    finish_dispatch(*channel, needsCleanup, count);
+    if (has_waiters(*channel)) {
+        for (std::size_t e = 0; e < count; ++e) {
+            wake_waiters(*channel, bytes + e * stride);
+        }
+    }
+}
+
+template<typename Invoke>
+EventResult EventDispatcher::dispatch_type_erased_with(EventTypeIndex eventIndex, const void* eventData,
+                                                       Invoke&& invoke) {
+    detail::ListenerChannel* channel = nullptr;
+    InvokeOutcome outcome;
+
+    {
+        detail::EpochGuard guard;
+
+        const ListenerSnapshot* snapshot = resolve_listeners(eventIndex, channel);
+        if (!snapshot && !(channel && (channel->keyed.load(std::memory_order_seq_cst) || has_waiters(*channel)))) {
+            return EventResult::Continue; // No listeners for this event type
+        }
+
+        outcome = invoke_routed(*channel, snapshot, eventData, invoke);
+    }
+
+    finish_dispatch(*channel, outcome.sawExpired, 1);
+    wake_waiters(*channel, eventData);
+    return outcome.consumed ? EventResult::Consumed : EventResult::Continue;
+}
+
+bool EventDispatcher::invoke_on_strand(const ListenerSnapshot& snapshot, std::size_t index, const void* eventData) {
+    const std::uint32_t strand = snapshot.flags(index).strand;
+    if (strand == ListenerConcurrency::kAnyStrand) {
+        return snapshot.invoke(index, eventData);
+    }
+
+    std::lock_guard lock(strandLocks_[strand % kStrandLockCount]);
+    return snapshot.invoke(index, eventData);
+}
+
+template<typename Invoke>
+EventDispatcher::InvokeOutcome EventDispatcher::invoke_listeners(const ListenerSnapshot& snapshot,
+                                                                 const void* eventData, Invoke&& invoke) {
+    return invoke_listeners(&snapshot, nullptr, eventData, invoke);
+}
+
+template<typename Invoke>
+EventDispatcher::InvokeOutcome EventDispatcher::invoke_listeners(const ListenerSnapshot* snapshot,
+                                                                 const ListenerSnapshot* keyed, const void* eventData,
+                                                                 Invoke&& invoke) {
+    if constexpr (kInstrumentationEnabled) {
+        if (instrumenting()) {
+            return invoke_listeners_with(snapshot, keyed, eventData,
+                [this, &invoke](const ListenerSnapshot& listeners, std::size_t index, const void* data) {
+                    return timed_callback(listeners, index, [&] { return invoke(listeners, index, data); });
+                });
+        }
+    }
+    return invoke_listeners_with(snapshot, keyed, eventData, invoke);
+}
+
+template<typename Invoke>
+EventDispatcher::InvokeOutcome EventDispatcher::invoke_routed(detail::ListenerChannel& channel,
+                                                              const ListenerSnapshot* snapshot, const void* eventData,
+                                                              Invoke&& invoke) {
+    detail::ListenerChannel* keyedChannel = nullptr;
+    const ListenerSnapshot* keyed = find_keyed_listeners(channel, eventData, keyedChannel);
+    if (!keyed) {
+        return snapshot ? invoke_listeners(*snapshot, eventData, invoke) : InvokeOutcome{};
+    }
+
+    const InvokeOutcome outcome = invoke_listeners(snapshot, keyed, eventData, invoke);
+    if (outcome.sawExpired) {
+        mark_dirty(*keyedChannel);
+    }
+    return outcome;
+}
+
+void EventDispatcher::dispatch_queued_batch(detail::QueuedEvent* batch, std::size_t count, DeferredOrder order) {
+    BatchEntry entries[kDequeueBatchSize];
+    for (std::size_t i = 0; i < count; ++i) {
+        entries[i] = BatchEntry{batch[i].type_index(), batch[i].data()};
+    }
+
+    if (order == DeferredOrder::GroupByType) {
+        std::stable_sort(entries, entries + count,
+            [](const BatchEntry& a, const BatchEntry& b) { return a.typeIndex < b.typeIndex; });
+    }
+
+    for (std::size_t runBegin = 0; runBegin < count;) {
+        std::size_t runEnd = runBegin + 1;
+        while (runEnd < count && entries[runEnd].typeIndex == entries[runBegin].typeIndex) {
+            ++runEnd;
+        }
+        dispatch_run(entries[runBegin].typeIndex, entries + runBegin, runEnd - runBegin);
+        runBegin = runEnd;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        batch[i].reset();
+    }
+}
+
+void EventDispatcher::dispatch_run(EventTypeIndex eventIndex, const BatchEntry* entries, std::size_t count) {
+    detail::ListenerChannel* channel = nullptr;
+    bool needsCleanup = false;
+
+    {
+        detail::EpochGuard guard;
+
+        const ListenerSnapshot* snapshot = resolve_listeners(eventIndex, channel);
+        if (!snapshot && !(channel && (channel->keyed.load(std::memory_order_seq_cst) || has_waiters(*channel)))) {
+            return;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            needsCleanup |= invoke_routed(*channel, snapshot, entries[i].eventData).sawExpired;
+        }
+    }
+
+    finish_dispatch(*channel, needsCleanup, count);
+    if (has_waiters(*channel)) {
+        for (std::size_t i = 0; i < count; ++i) {
+            wake_waiters(*channel, entries[i].eventData);
+        }
+    }
+}
+
+void EventDispatcher::wake_waiters(detail::ListenerChannel& channel, const void* eventData) {
+    if (!has_waiters(channel)) {
+        return;
+    }
+
+    detail::EventWaiter* ready = nullptr;
+    detail::EventWaiter** readyTail = &ready;
+    {
+        std::lock_guard lock(waitersMutex_);
+        for (detail::EventWaiter* waiter = channel.waiters.load(std::memory_order_relaxed); waiter;) {
+            detail::EventWaiter* next = waiter->next;
+            if (waiter->offer(*waiter, eventData)) {
+                unlink_waiter_locked(*waiter);
+                waiter->next = nullptr;
+                *readyTail = waiter;
+                readyTail = &waiter->next;
+            }
+            waiter = next;
+        }
+    }
+
+    while (ready) {
+        detail::EventWaiter* waiter = ready;
+        ready = waiter->next;
+        waiter->continuation.resume();     // May destroy the waiter
+    }
+}
+
+void EventDispatcher::record_queue_dwell(const detail::QueuedEvent* events, std::size_t count) {
+#if EVENTCORE_ENABLE_INSTRUMENTATION
+    if (!instrumentationActive_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const std::uint64_t now = detail::instrumentation_clock();
+    detail::EpochGuard guard;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (detail::ListenerChannel* channel = find_channel(events[i].type_index())) {
+            channel->recorder.queueDwell.record(now - events[i].enqueued_at());
+        }
+    }
+#else
+    (void)events;
+    (void)count;
+#endif
+}
+
+void EventDispatcher::finish_dispatch(detail::ListenerChannel& channel, bool sawExpired, std::size_t count) {
+    if (sawExpired) {
+        mark_dirty(channel);
+    }
+
+    if constexpr (kStatisticsEnabled) {
+        counters_.add(kDispatchCounter, count);
+    }
+#if EVENTCORE_ENABLE_INSTRUMENTATION
+    if (instrumentationActive_.load(std::memory_order_relaxed)) {
+        channel.recorder.dispatches.fetch_add(count, std::memory_order_relaxed);
+    }
+#endif
+
+    if (cleanupPolicy_.mode != CleanupPolicy::Mode::Amortized ||
+        dirtyChannels_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    const std::size_t previous = counters_.add(kCleanupTickCounter, count);
+    const std::size_t interval = std::max<std::size_t>(1, cleanupPolicy_.dispatchInterval);
+    if (previous / interval == (previous + count) / interval) {
+        return;
+    }
+
+    std::unique_lock lock(writeMutex_, std::try_to_lock);
+    if (lock.owns_lock()) {
+        compact_dirty_channels_locked(cleanupPolicy_.channelBudget);
+    }
+    // Otherwise a writer is busy; the next interval retries
+}
+
+// co_await waiters
+
+void EventDispatcher::begin_wait(EventTypeIndex eventIndex, detail::EventWaiter& waiter) {
+    detail::ListenerChannel* channel = nullptr;
+    {
+        detail::EpochGuard guard;
+        channel = find_channel(eventIndex);
+    }
+    if (!channel) {
+        std::lock_guard lock(writeMutex_);
+        channel = &get_or_create_channel_locked(eventIndex);
+    }
+
+    std::lock_guard lock(waitersMutex_);
+    waiter.channel = channel;
+    waiter.prev = channel->lastWaiter;
+    waiter.next = nullptr;
+    if (channel->lastWaiter) {
+        channel->lastWaiter->next = &waiter;
+    } else {
+        channel->waiters.store(&waiter, std::memory_order_release);
+    }
+    channel->lastWaiter = &waiter;
+}
+
+void EventDispatcher::cancel_wait(detail::EventWaiter& waiter) {
+    std::lock_guard lock(waitersMutex_);
+    if (waiter.channel) {
+        unlink_waiter_locked(waiter);
+    }
+}
+
+void EventDispatcher::unlink_waiter_locked(detail::EventWaiter& waiter) noexcept {
+    detail::ListenerChannel& channel = *waiter.channel;
+    if (waiter.prev) {
+        waiter.prev->next = waiter.next;
+    } else {
+        channel.waiters.store(waiter.next, std::memory_order_release);
+    }
+    if (waiter.next) {
+        waiter.next->prev = waiter.prev;
+    } else {
+        channel.lastWaiter = waiter.prev;
+    }
+    waiter.channel = nullptr;
+}
+
+// Deferred queue
+
+template<typename DequeueBulk>
+std::size_t EventDispatcher::drain_queue(std::size_t maxEvents, DeferredOrder order, DequeueBulk&& dequeueBulk) {
+    using Clock = std::chrono::steady_clock;
+
+    DrainScope drainScope(this);
+    detail::QueuedEvent batch[kDequeueBatchSize];
+    std::size_t processedCount = 0;
+    LaneAllowance allowance = lane_allowance();
+    collect_due_events();
+
+    while (maxEvents == 0 || processedCount < maxEvents) {
+        std::size_t batchLimit = kDequeueBatchSize;
+        if (maxEvents != 0) {
+            batchLimit = std::min(batchLimit, maxEvents - processedCount);
+        }
+
+        // Due scheduled events come first, then the lanes by priority, coalesced
+        // overflow events once the lanes are empty
+        std::size_t lane = kDeferredLaneCount;
+        std::size_t count = delayedEvents_.take_ready(batch, batchLimit);
+        if (count == 0) {
+            bool budgetHit = false;
+            count = dequeue_by_priority(allowance, batch, batchLimit, lane, budgetHit, dequeueBulk);
+            if (count != 0) {
+                release_slots(count);
+                allowance.events[lane] -= count;
+            } else {
+                count = budgetHit ? 0 : overflowTable_.take(batch, batchLimit);
+                if (count == 0) {
+                    break;
+                }
+            }
+            count_dequeued(count);
+        }
+
+        count = resolve_placeholders(batch, count);
+        record_queue_dwell(batch, count);
+        if (lane != kDeferredLaneCount && allowance.time[lane] != std::chrono::nanoseconds::max()) {
+            const auto start = Clock::now();
+            dispatch_queued_batch(batch, count, order);
+            allowance.time[lane] -= Clock::now() - start;
+        } else {
+            dispatch_queued_batch(batch, count, order);
+        }
+        processedCount += count;
+    }
+
+    return processedCount;
+}
+
+EventDispatcher::LaneAllowance EventDispatcher::lane_allowance() const noexcept {
+    LaneAllowance allowance;
+    for (std::size_t lane = 0; lane < kDeferredLaneCount; ++lane) {
+        allowance.events[lane] = lane_event_budget(lane);
+        allowance.time[lane] = laneBudgets_[lane].maxTime > std::chrono::nanoseconds::zero()
+            ? laneBudgets_[lane].maxTime : std::chrono::nanoseconds::max();
+    }
+    return allowance;
+}
+
+std::size_t EventDispatcher::lane_event_budget(std::size_t lane) const noexcept {
+    return laneBudgets_[lane].maxEvents != 0 ? laneBudgets_[lane].maxEvents
+                                             : std::numeric_limits<std::size_t>::max();
+}
+
+template<typename DequeueBulk>
+std::size_t EventDispatcher::dequeue_by_priority(const LaneAllowance& allowance, detail::QueuedEvent* batch,
+                                                 std::size_t batchLimit, std::size_t& lane, bool& budgetHit,
+                                                 DequeueBulk& dequeueBulk) {
+    for (std::size_t next = kDeferredLaneCount; next > 0; --next) {
+        const std::size_t candidate = next - 1;
+        if (allowance.events[candidate] == 0 || allowance.time[candidate] <= std::chrono::nanoseconds::zero()) {
+            budgetHit = budgetHit || eventQueues_[candidate].size_approx() != 0;
+            continue;
+        }
+
+        const std::size_t count = dequeueBulk(candidate, batch, std::min(batchLimit, allowance.events[candidate]));
+        if (count != 0) {
+            lane = candidate;
+            return count;
+        }
+    }
+    return 0;
+}
+
+bool EventDispatcher::has_queued_events() const noexcept {
+    for (const EventQueue& queue : eventQueues_) {
+        if (queue.size_approx() != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Drain>
+std::size_t EventDispatcher::wait_and_drain(std::chrono::nanoseconds timeout, Drain&& drain) {
+    using Clock = std::chrono::steady_clock;
+
+    std::size_t processedCount = drain();
+    if (processedCount != 0 || timeout <= std::chrono::nanoseconds::zero() || DrainScope::current() == this) {
+        return processedCount;
+    }
+
+    const std::uint64_t interrupts = interruptSequence_.load(std::memory_order_relaxed);
+    const auto now = Clock::now();
+    const auto deadline = timeout < Clock::time_point::max() - now ? now + timeout : Clock::time_point::max();
+
+    // Spin, then yield: re-checks cheap enough to catch a burst without a scheduler round trip
+    const std::uint32_t idleRounds = waitStrategy_.spinCount + waitStrategy_.yieldCount;
+    for (std::uint32_t round = 0; round < idleRounds; ++round) {
+        if (round < waitStrategy_.spinCount) {
+            detail::cpu_relax();
+        } else {
+            std::this_thread::yield();
+            if (Clock::now() >= deadline) {
+                return 0;
+            }
+        }
+        if (interruptSequence_.load(std::memory_order_relaxed) != interrupts) {
+            return drain();
+        }
+
+        if (has_queued_events() && (processedCount = drain()) != 0) {
+            return processedCount;
+        }
+    }
+
+    for (;;) {
+        // Scheduled events are not signalled when they fall due: wake every tick while any are pending
+        auto wakeAt = deadline;
+        const std::size_t scheduledCount = delayedEvents_.pending();
+        if (scheduledCount != 0) {
+            wakeAt = std::min(wakeAt, Clock::now() + delayedEvents_.resolution());
+        }
+
+        park_until(wakeAt, scheduledCount, interrupts);
+        const bool interrupted = interruptSequence_.load(std::memory_order_relaxed) != interrupts;
+        if ((processedCount = drain()) != 0 || interrupted || Clock::now() >= deadline) {
+            return processedCount;
+        }
+    }
+}
+
+void EventDispatcher::park_until(std::chrono::steady_clock::time_point wakeAt, std::size_t scheduledCount,
+                                 std::uint64_t interrupts) {
+    std::unique_lock lock(park_->mutex);
+    const std::uint64_t wakes = park_->wakeSequence;
+    if (interruptSequence_.load(std::memory_order_relaxed) != interrupts) {
+        return;
+    }
+
+    // Pairs with the fence in signal_parked_consumers(): either this re-check
+    // sees the producer's event or the producer sees this consumer parked
+    parkedConsumers_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!has_queued_events() && delayedEvents_.pending() == scheduledCount) {
+        park_->signal.wait_until(lock, wakeAt, [this, wakes] { return park_->wakeSequence != wakes; });
+    }
+    parkedConsumers_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void EventDispatcher::notify_parked_consumers() {
+    {
+        std::lock_guard lock(park_->mutex);
+        ++park_->wakeSequence;
+    }
+    park_->signal.notify_all();
+}
+
+std::size_t EventDispatcher::resolve_placeholders(detail::QueuedEvent* events, std::size_t count) {
+    if (!latestEvents_.in_use()) {
+        return count;
+    }
+
+    std::size_t keptCount = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (events[i].is_placeholder()) {
+            std::uint64_t key = 0;
+            events[i].key(key);
+            events[i] = latestEvents_.take(events[i].type_index(), key);
+            if (!events[i]) {
+                continue;
+            }
+        }
+        if (keptCount != i) {
+            events[keptCount] = std::move(events[i]);
+        }
+        ++keptCount;
+    }
+    return keptCount;
+}
+
+EventDispatcher::Admission EventDispatcher::admit_overflow(detail::QueuedEvent& event) {
+    switch (queuePolicy_.overflow) {
+        case OverflowPolicy::Block:
+            wait_for_slot();
+            return Admission::Enqueue;
+
+        case OverflowPolicy::DropNewest:
+            droppedEvents_.fetch_add(1, std::memory_order_relaxed);
+            return Admission::Rejected;
+
+        case OverflowPolicy::DropOldest:
+            evict_oldest();
+            return Admission::Enqueue;
+
+        case OverflowPolicy::Coalesce: {
+            std::uint64_t key = 0;
+            if (!event.key(key)) {
+                droppedEvents_.fetch_add(1, std::memory_order_relaxed);
+                return Admission::Rejected;
+            }
+            if (overflowTable_.store(key, std::move(event))) {
+                coalescedEvents_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                count_enqueued(1);
+            }
+            return Admission::Absorbed;
+        }
+    }
+    return Admission::Rejected;
+}
+
+void EventDispatcher::wait_for_slot() {
+    // A callback re-enqueueing while this thread drains cannot wait for
+    // itself, so it is admitted over capacity instead
+    if (DrainScope::current() == this) {
+        queueOccupancy_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    blockedProducers_.fetch_add(1);
+    while (try_reserve_slots(1) == 0) {
+        const std::size_t occupied = queueOccupancy_.load();
+        if (occupied >= queuePolicy_.capacity) {
+            queueOccupancy_.wait(occupied);
+        }
+    }
+    blockedProducers_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void EventDispatcher::evict_oldest() {
+    for (;;) {
+        detail::QueuedEvent oldest;
+        for (EventQueue& queue : eventQueues_) {
+            if (queue.try_dequeue(oldest)) {
+                if (oldest.is_placeholder()) {
+                    // Left behind, the value would make every later store() of its key a silent no-op
+                    std::uint64_t key = 0;
+                    oldest.key(key);
+                    latestEvents_.take(oldest.type_index(), key);
+                }
+                count_dequeued(1);
+                droppedEvents_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        // Every slot is reserved by an event still being enqueued, or a consumer just freed one
+        if (try_reserve_slots(1) != 0) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+// Listener registration and channels
+
+void EventDispatcher::mark_dirty(detail::ListenerChannel& channel) {
+    if (!channel.dirty.load(std::memory_order_relaxed) &&
+        !channel.dirty.exchange(true, std::memory_order_acq_rel)) {
+        dirtyChannels_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::size_t EventDispatcher::compact_dirty_channels_locked(std::size_t channelBudget) {
+    std::size_t removedCount = 0;
+    std::size_t compactedCount = 0;
+
+    for (auto& channel : channels_) {
+        if (channelBudget != 0 && compactedCount == channelBudget) {
+            break;
+        }
+        if (!channel->dirty.load(std::memory_order_relaxed) ||
+            !channel->dirty.exchange(false, std::memory_order_acq_rel)) {
+            continue;
+        }
+
+        // May briefly wrap if a reader's increment is still in flight; only a hint
+        dirtyChannels_.fetch_sub(1, std::memory_order_relaxed);
+        removedCount += cleanup_channel_locked(*channel);
+        ++compactedCount;
+    }
+
+    totalListeners_.fetch_sub(removedCount, std::memory_order_relaxed);
+    return removedCount;
+}
+
+SubscriptionHandle EventDispatcher::insert_listener(EventTypeIndex eventIndex, detail::InternalListener&& listener) {
+    std::lock_guard lock(writeMutex_);
+    return insert_listener_locked(get_or_create_channel_locked(eventIndex), std::move(listener));
+}
+
+SubscriptionHandle EventDispatcher::insert_keyed_listener(EventTypeIndex eventIndex, std::uint64_t key,
+                                                          detail::KeyedChannelIndex::KeyOf keyOf,
+                                                          detail::InternalListener&& listener) {
+    std::lock_guard lock(writeMutex_);
+
+    detail::ListenerChannel& channel = get_or_create_channel_locked(eventIndex);
+    return insert_listener_locked(get_or_create_keyed_channel_locked(channel, key, keyOf), std::move(listener));
+}
+
+SubscriptionHandle EventDispatcher::insert_listener_locked(detail::ListenerChannel& channel,
+                                                           detail::InternalListener&& listener) {
+    listener.slot = acquire_slot_locked(channel);
+
+    ListenerSnapshot* snapshot = channel.snapshot.load(std::memory_order_relaxed);
+    if (!snapshot || !snapshot->has_room(listener.priority)) {
+        const std::size_t expiredCount =
+            rebuild_snapshot_locked(channel, ListenerSnapshot::band_of(listener.priority));
+        totalListeners_.fetch_sub(expiredCount, std::memory_order_relaxed);
+        snapshot = channel.snapshot.load(std::memory_order_relaxed);
+    }
+
+    SubscriptionSlot& slot = slots_[listener.slot];
+    slot.position = snapshot->append(listener);
+    totalListeners_.fetch_add(1, std::memory_order_relaxed);
+    inherit_listener_locked(channel, listener);
+    return SubscriptionHandle(listener.slot, slot.generation);
+}
+
+void EventDispatcher::unsubscribe_matching(EventTypeIndex eventIndex, const detail::Delegate& callback) {
+    std::lock_guard lock(writeMutex_);
+
+    detail::ListenerChannel* channel = find_channel_locked(eventIndex);
+    if (!channel) {
+        return;
+    }
+
+    // Collect first: a removal may rebuild the snapshot or unlink a per-key channel
+    std::vector<std::uint32_t> matchingSlots;
+    auto collect = [&](const ListenerSnapshot* snapshot) {
+        if (!snapshot) {
+            return;
+        }
+        snapshot->for_each([&](std::size_t i) {
+            if (!snapshot->removed(i) && !snapshot->inherited(i) && snapshot->callback(i) == callback) {
+                matchingSlots.push_back(snapshot->slot(i));
+            }
+        });
+    };
+    collect(channel->snapshot.load(std::memory_order_relaxed));
+    if (const detail::KeyedChannelIndex* index = channel->keyed.load(std::memory_order_relaxed)) {
+        index->for_each([&](std::uint64_t, const detail::ListenerChannel* keyedChannel) {
+            collect(keyedChannel->snapshot.load(std::memory_order_relaxed));
+        });
+    }
+
+    for (std::uint32_t slotId : matchingSlots) {
+        remove_subscription_locked(slotId);
+    }
+}
+
+void EventDispatcher::remove_subscription_locked(std::uint32_t slotId) {
+    detail::ListenerChannel& channel = *slots_[slotId].channel;
+    ListenerSnapshot* snapshot = channel.snapshot.load(std::memory_order_relaxed);
+
+    snapshot->remove(slots_[slotId].position);
+    release_slot_locked(slotId);
+    totalListeners_.fetch_sub(1, std::memory_order_relaxed);
+    disinherit_listener_locked(channel, slotId);
+
+    // Bound tombstones whatever the cleanup policy; amortized O(1) per removal
+    if (snapshot->tombstone_count() * 2 >= snapshot->entry_count()) {
+        const std::size_t expiredCount = rebuild_snapshot_locked(channel, ListenerSnapshot::kPriorityCount);
+        totalListeners_.fetch_sub(expiredCount, std::memory_order_relaxed);
+    } else {
+        mark_dirty(channel);
+    }
+}
+
+void EventDispatcher::inherit_listener_locked(detail::ListenerChannel& channel,
+                                              const detail::InternalListener& listener) {
+    for (detail::ListenerChannel* descendant : channel.descendants) {
+        if (listener.batched) {
+            // Batch listeners only see their exact type; forget a dropped copy that held the slot before
+            descendant->inheritedPositions.erase(listener.slot);
+            continue;
+        }
+
+        ListenerSnapshot* snapshot = descendant->snapshot.load(std::memory_order_relaxed);
+        if (!snapshot || !snapshot->has_room(listener.priority)) {
+            // Collects the new listener from channel along with the rest
+            const std::size_t expiredCount =
+                rebuild_snapshot_locked(*descendant, ListenerSnapshot::band_of(listener.priority));
+            totalListeners_.fetch_sub(expiredCount, std::memory_order_relaxed);
+            continue;
+        }
+
+        detail::InternalListener copy = listener;
+        copy.inherited = true;
+        for (const auto& ancestor : descendant->ancestors) {
+            if (ancestor.channel == &channel) {
+                copy.upcast = ancestor.upcast;
+                break;
+            }
+        }
+        descendant->inheritedPositions[listener.slot] = static_cast<std::uint32_t>(snapshot->append(copy));
+    }
+}
+
+void EventDispatcher::disinherit_listener_locked(detail::ListenerChannel& channel, std::uint32_t slotId) {
+    for (detail::ListenerChannel* descendant : channel.descendants) {
+        const auto it = descendant->inheritedPositions.find(slotId);
+        if (it == descendant->inheritedPositions.end()) {
+            continue;   // Batch listener, or its copy was dropped as expired
+        }
+        ListenerSnapshot* snapshot = descendant->snapshot.load(std::memory_order_relaxed);
+        const std::size_t position = it->second;
+        descendant->inheritedPositions.erase(it);
+
+        snapshot->remove(position);
+        if (snapshot->tombstone_count() * 2 >= snapshot->entry_count()) {
+            const std::size_t expiredCount = rebuild_snapshot_locked(*descendant, ListenerSnapshot::kPriorityCount);
+            totalListeners_.fetch_sub(expiredCount, std::memory_order_relaxed);
+        } else {
+            mark_dirty(*descendant);
+        }
+    }
+}
+
+void EventDispatcher::link_event_hierarchy() {
+    std::lock_guard lock(writeMutex_);
+
+    const std::uint32_t generation = detail::EventTypeRegistry::hierarchy_generation();
+    for (EventTypeIndex eventIndex : detail::EventTypeRegistry::derived_types()) {
+        get_or_create_channel_locked(eventIndex);
+    }
+    hierarchyGeneration_.store(generation, std::memory_order_relaxed);
+}
+
+std::uint32_t EventDispatcher::acquire_slot_locked(detail::ListenerChannel& channel) {
+    std::uint32_t slotId;
+    if (!freeSlots_.empty()) {
+        slotId = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slotId = static_cast<std::uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    SubscriptionSlot& slot = slots_[slotId];
+    slot.active = true;
+    slot.channel = &channel;
+    slot.sequence = nextSequence_++;
+#if EVENTCORE_ENABLE_INSTRUMENTATION
+    listenerRecorders_.prepare(slotId);
+#endif
+    return slotId;
+}
+
+void EventDispatcher::release_slot_locked(std::uint32_t slotId) {
+    SubscriptionSlot& slot = slots_[slotId];
+    slot.active = false;
+    slot.channel = nullptr;
+
+    // Invalidates outstanding handles; 0 is reserved for empty handles
+    if (++slot.generation == 0) {
+        slot.generation = 1;
+    }
+    freeSlots_.push_back(slotId);
+}
+
+const EventDispatcher::ListenerSnapshot* EventDispatcher::resolve_listeners(EventTypeIndex eventIndex,
+                                                                            detail::ListenerChannel*& channel) {
+    channel = find_channel(eventIndex);
+    const ListenerSnapshot* snapshot = channel ? channel->snapshot.load(std::memory_order_seq_cst) : nullptr;
+    if (!snapshot && hierarchy_stale()) {
+        link_event_hierarchy();
+        channel = find_channel(eventIndex);
+        snapshot = channel ? channel->snapshot.load(std::memory_order_seq_cst) : nullptr;
+    }
+    return snapshot;
+}
+
+const EventDispatcher::ListenerSnapshot* EventDispatcher::find_keyed_listeners(
+    const detail::ListenerChannel& channel, const void* eventData, detail::ListenerChannel*& keyedChannel) {
+    const detail::KeyedChannelIndex* index = channel.keyed.load(std::memory_order_seq_cst);
+    if (!index) {
+        return nullptr;
+    }
+
+    const std::uint64_t key = index->keyOf(eventData);
+    detail::ListenerChannel* found = index->find(key);
+    if (!found) {
+        return nullptr;
+    }
+
+    const ListenerSnapshot* snapshot = found->snapshot.load(std::memory_order_seq_cst);
+    if (found->key.load(std::memory_order_seq_cst) != key) {
+        return nullptr;
+    }
+    keyedChannel = found;
+    return snapshot;
+}
+
+detail::ListenerChannel* EventDispatcher::find_channel_locked(EventTypeIndex eventIndex) const {
+    const ChannelTable* channelTable = channelTable_.load(std::memory_order_relaxed);
+    if (!channelTable || eventIndex >= channelTable->size()) {
+        return nullptr;
+    }
+    return (*channelTable)[eventIndex];
+}
+
+detail::ListenerChannel& EventDispatcher::get_or_create_channel_locked(EventTypeIndex eventIndex) {
+    if (detail::ListenerChannel* channel = find_channel_locked(eventIndex)) {
+        return *channel;
+    }
+
+    channels_.push_back(std::make_unique<detail::ListenerChannel>());
+    detail::ListenerChannel* channel = channels_.back().get();
+
+    const ChannelTable* current = channelTable_.load(std::memory_order_relaxed);
+    auto* next = current ? new ChannelTable(*current) : new ChannelTable();
+    if (next->size() <= eventIndex) {
+        next->resize(static_cast<std::size_t>(eventIndex) + 1, nullptr);
+    }
+    (*next)[eventIndex] = channel;
+
+    channelTable_.exchange(next, std::memory_order_seq_cst);
+    detail::EpochDomain::instance().retire(current);
+
+    // Declared base types (event_base) hand their listeners down to this one
+    for (const auto& ancestor : detail::EventTypeRegistry::ancestors(eventIndex)) {
+        detail::ListenerChannel& base = get_or_create_channel_locked(ancestor.index);
+        base.descendants.push_back(channel);
+        channel->ancestors.push_back(detail::ListenerChannel::Ancestor{&base, ancestor.upcast});
+    }
+    if (!channel->ancestors.empty()) {
+        rebuild_snapshot_locked(*channel, ListenerSnapshot::kPriorityCount);
+    }
+    return *channel;
+}
+
+detail::ListenerChannel& EventDispatcher::get_or_create_keyed_channel_locked(detail::ListenerChannel& parent,
+                                                                             std::uint64_t key,
+                                                                             detail::KeyedChannelIndex::KeyOf keyOf) {
+    detail::KeyedChannelIndex* index = parent.keyed.load(std::memory_order_relaxed);
+    if (index) {
+        if (detail::ListenerChannel* existing = index->find(key)) {
+            return *existing;
+        }
+    }
+
+    detail::ListenerChannel* channel = nullptr;
+    if (!parent.freeKeyed.empty()) {
+        channel = parent.freeKeyed.back();
+        parent.freeKeyed.pop_back();
+    } else {
+        channels_.push_back(std::make_unique<detail::ListenerChannel>());
+        channel = channels_.back().get();
+    }
+    channel->key.store(key, std::memory_order_seq_cst);
+    channel->keyedParent = &parent;
+
+    // Rehash only when full, at twice the live keys, so each new key is amortized O(1)
+    if (!index || !index->has_room()) {
+        const std::size_t liveKeys = index ? index->size() : 0;
+        const std::size_t capacity =
+            std::max(detail::KeyedChannelIndex::kMinCapacity, std::bit_ceil((liveKeys + 1) * 2));
+        auto* next = index ? new detail::KeyedChannelIndex(*index, capacity)
+                           : new detail::KeyedChannelIndex(keyOf, capacity);
+        parent.keyed.exchange(next, std::memory_order_seq_cst);
+        detail::EpochDomain::instance().retire(index);
+        index = next;
+    }
+    index->insert(key, channel);
+    return *channel;
+}
+
+void EventDispatcher::unlink_keyed_channel_locked(detail::ListenerChannel& channel) {
+    detail::ListenerChannel& parent = *channel.keyedParent;
+    detail::KeyedChannelIndex* index = parent.keyed.load(std::memory_order_relaxed);
+
+    // Tombstoned in place; the type drops its index with its last key
+    index->erase(channel.key.load(std::memory_order_relaxed));
+    if (index->size() == 0) {
+        parent.keyed.exchange(nullptr, std::memory_order_seq_cst);
+        detail::EpochDomain::instance().retire(index);
+    }
+
+    channel.keyedParent = nullptr;
+    parent.freeKeyed.push_back(&channel);
+}
+
+std::size_t EventDispatcher::rebuild_snapshot_locked(detail::ListenerChannel& channel, std::size_t growBand) {
+    static constexpr std::size_t kMinBandCapacity = 4;
+
+    ListenerSnapshot* current = channel.snapshot.load(std::memory_order_relaxed);
+    ListenerVector listenerVec;
+    std::array<std::size_t, ListenerSnapshot::kPriorityCount> bandCounts{};
+    std::size_t expiredCount = 0;
+
+    if (current) {
+        listenerVec.reserve(current->live_count());
+        current->for_each([&](std::size_t i) {
+            if (current->removed(i) || current->inherited(i)) {
+                return;     // Slot already released by unsubscribe; copies are re-collected below
+            }
+            if (current->expired(i)) {
+                release_slot_locked(current->slot(i));
+                ++expiredCount;
+                return;
+            }
+            listenerVec.push_back(current->listener(i));
+            ++bandCounts[ListenerSnapshot::band_of(listenerVec.back().priority)];
+        });
+    }
+
+    // Flatten the ancestors' own listeners in; batch listeners only see their exact type
+    for (const auto& ancestor : channel.ancestors) {
+        const ListenerSnapshot* inheritedFrom = ancestor.channel->snapshot.load(std::memory_order_relaxed);
+        if (!inheritedFrom) {
+            continue;
+        }
+        inheritedFrom->for_each([&](std::size_t i) {
+            if (inheritedFrom->removed(i) || inheritedFrom->inherited(i) || inheritedFrom->flags(i).batched) {
+                return;
+            }
+            if (inheritedFrom->expired(i)) {
+                mark_dirty(*ancestor.channel);     // The ancestor releases the slot when compacted
+                return;
+            }
+            detail::InternalListener& copy = listenerVec.emplace_back(inheritedFrom->listener(i));
+            copy.inherited = true;
+            copy.upcast = ancestor.upcast;
+            ++bandCounts[ListenerSnapshot::band_of(copy.priority)];
+        });
+    }
+    if (!channel.ancestors.empty()) {
+        std::stable_sort(listenerVec.begin(), listenerVec.end(),
+            [this](const detail::InternalListener& a, const detail::InternalListener& b) {
+                const std::size_t bandA = ListenerSnapshot::band_of(a.priority);
+                const std::size_t bandB = ListenerSnapshot::band_of(b.priority);
+                return bandA != bandB ? bandA < bandB : slots_[a.slot].sequence < slots_[b.slot].sequence;
+            });
+    }
+
+    ListenerSnapshot* next = nullptr;
+    channel.inheritedPositions.clear();
+    if (!listenerVec.empty() || growBand < ListenerSnapshot::kPriorityCount) {
+        ListenerSnapshot::BandCapacities capacities{};
+        for (std::size_t band = 0; band < ListenerSnapshot::kPriorityCount; ++band) {
+            capacities[band] = bandCounts[band] == 0 ? 0 : std::bit_ceil(bandCounts[band]);
+        }
+        if (growBand < ListenerSnapshot::kPriorityCount) {
+            capacities[growBand] = std::max(kMinBandCapacity, std::bit_ceil(bandCounts[growBand] + 1));
+        }
+
+        next = new ListenerSnapshot(capacities, !channel.ancestors.empty());
+        for (const auto& listener : listenerVec) {
+            const std::size_t position = next->append(listener);
+            if (listener.inherited) {
+                channel.inheritedPositions[listener.slot] = static_cast<std::uint32_t>(position);
+            } else {
+                slots_[listener.slot].position = position;
+            }
+        }
+    }
+
+    ListenerSnapshot* previous = channel.snapshot.exchange(next, std::memory_order_seq_cst);
+    detail::EpochDomain::instance().retire(previous);
+    if (!next && channel.keyedParent) {
+        unlink_keyed_channel_locked(channel);
+    }
+    return expiredCount;
+}
+
+std::size_t EventDispatcher::cleanup_channel_locked(detail::ListenerChannel& channel) {
+    const ListenerSnapshot* current = channel.snapshot.load(std::memory_order_relaxed);
+    if (!current) {
+        return 0;
+    }
+
+    bool stale = current->tombstone_count() != 0;
+    if (!stale) {
+        current->for_each([&](std::size_t i) {
+            stale = stale || current->expired(i);
+        });
+    }
+
+    return stale ? rebuild_snapshot_locked(channel, ListenerSnapshot::kPriorityCount) : 0;
+}
+
+// Instrumentation export
 
-// If needed, non-templated utility functions could be implemented here.
+void InstrumentationSnapshot::write_json(std::ostream& out) const {
+    auto writeHistogram = [&out](const LatencyHistogram& histogram) {
+        out << "{\"count\":" << histogram.count
+            << ",\"meanNs\":" << histogram.mean_nanoseconds()
+            << ",\"p50Ns\":" << histogram.percentile_nanoseconds(0.5)
+            << ",\"p99Ns\":" << histogram.percentile_nanoseconds(0.99)
+            << ",\"maxNs\":" << histogram.maxNanoseconds
+            << ",\"buckets\":[";
+        for (std::size_t bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket) {
+            out << (bucket ? "," : "") << histogram.buckets[bucket];
+        }
+        out << "]}";
+    };
+    
+    out << "{\"eventTypes\":[";
+    for (std::size_t i = 0; i < eventTypes.size(); ++i) {
+        const EventTypeMetrics& type = eventTypes[i];
+        out << (i ? "," : "") << "{\"typeId\":" << type.typeId
+            << ",\"dispatches\":" << type.dispatchCount
+            << ",\"queueDwell\":";
+        writeHistogram(type.queueDwell);
+        out << ",\"listeners\":[";
+        for (std::size_t j = 0; j < type.listeners.size(); ++j) {
+            const ListenerMetrics& listener = type.listeners[j];
+            out << (j ? "," : "") << "{\"instance\":\"" << listener.instance
+                << "\",\"priority\":" << static_cast<int>(listener.priority)
+                << ",\"callbackTime\":";
+            writeHistogram(listener.callbackTime);
+            out << "}";
+        }
+        out << "]}";
+    }
+    out << "]}";
+}
 
-} // namespace EventCore 
\ No newline at end of file
+} // namespace EventCore
@@ -0,0 +1,179 @@
+#include "EventCore/EventRecorder.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace EventCore {
+namespace detail {
+
+#if defined(_WIN32)
+
+bool MappedFile::open_for_write(const std::string& path, std::size_t capacity) noexcept {
+    close();
+
+    HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    const auto size = static_cast<unsigned long long>(capacity);
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+                                          static_cast<DWORD>(size & 0xFFFFFFFFu), nullptr);
+    void* view = mapping ? ::MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, capacity) : nullptr;
+    if (!view) {
+        if (mapping) {
+            ::CloseHandle(mapping);
+        }
+        ::CloseHandle(file);
+        return false;
+    }
+
+    file_ = file;
+    mapping_ = mapping;
+    data_ = static_cast<std::byte*>(view);
+    size_ = capacity;
+    writable_ = true;
+    return true;
+}
+
+bool MappedFile::open_for_read(const std::string& path) noexcept {
+    close();
+
+    HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        ::CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            ::CloseHandle(mapping);
+        }
+        ::CloseHandle(file);
+        return false;
+    }
+
+    file_ = file;
+    mapping_ = mapping;
+    data_ = static_cast<std::byte*>(view);
+    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+    writable_ = false;
+    return true;
+}
+
+void MappedFile::close(std::size_t usedSize) noexcept {
+    if (!data_) {
+        return;
+    }
+
+    ::UnmapViewOfFile(data_);
+    ::CloseHandle(mapping_);
+    if (writable_) {
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(usedSize);
+        ::SetFilePointerEx(file_, end, nullptr, FILE_BEGIN);
+        ::SetEndOfFile(file_);
+    }
+    ::CloseHandle(file_);
+
+    file_ = nullptr;
+    mapping_ = nullptr;
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#else
+
+bool MappedFile::open_for_write(const std::string& path, std::size_t capacity) noexcept {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Extending with ftruncate leaves the file sparse until pages are written
+    void* view = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(capacity)) == 0) {
+        view = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    data_ = static_cast<std::byte*>(view);
+    size_ = capacity;
+    writable_ = true;
+    return true;
+}
+
+bool MappedFile::open_for_read(const std::string& path) noexcept {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info {};
+    void* view = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+        view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    ::madvise(view, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+
+    fd_ = fd;
+    data_ = static_cast<std::byte*>(view);
+    size_ = static_cast<std::size_t>(info.st_size);
+    writable_ = false;
+    return true;
+}
+
+void MappedFile::close(std::size_t usedSize) noexcept {
+    if (!data_) {
+        return;
+    }
+
+    ::munmap(data_, size_);
+    if (writable_) {
+        // Nothing useful to do if shrinking fails: the tail is zero-filled
+        (void)::ftruncate(fd_, static_cast<off_t>(usedSize));
+    }
+    ::close(fd_);
+
+    fd_ = -1;
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
+
+} // namespace detail
+} // namespace EventCore
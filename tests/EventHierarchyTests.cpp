@@ -0,0 +1,137 @@
+// Event hierarchies (event_base) in EventDispatcher: base subobjects that
+// do not start the derived event, multi-level flattening, priority order and
+// base listener churn.
+
+#include "EventCore/EventDispatcher.hpp"
+#include "TestSupport.hpp"
+
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace {
+
+struct DamageEvent : public EventCore::Event {
+    int amount = 0;
+    
+    DamageEvent() = default;
+    explicit DamageEvent(int a) : amount(a) {}
+};
+
+struct Tagged {
+    long tag = 77;
+};
+
+// Tagged comes first, so the DamageEvent subobject sits at a non-zero offset
+struct FireDamageEvent : public Tagged, public DamageEvent {
+    using event_base = DamageEvent;
+    float burnSeconds = 0.0f;
+    
+    FireDamageEvent() = default;
+    FireDamageEvent(int a, float seconds) : DamageEvent(a), burnSeconds(seconds) {}
+};
+
+struct InfernoEvent : public FireDamageEvent {
+    using event_base = FireDamageEvent;
+    int radius = 0;
+    
+    InfernoEvent(int a, int r) : FireDamageEvent(a, 2.5f), radius(r) {}
+};
+
+struct BatchRecorder {
+    std::vector<int>& order;
+    
+    explicit BatchRecorder(std::vector<int>& o) : order(o) {}
+    void on_damage(std::span<const DamageEvent>) { order.push_back(1000); }
+};
+
+// Base listeners see their own subobject of a derived event, at any depth
+void test_base_subobject_conversion() {
+    EventCore::EventDispatcher dispatcher;
+    std::vector<int> amounts;
+    std::vector<float> burns;
+    
+    dispatcher.subscribe<DamageEvent>([&](const DamageEvent& e) { amounts.push_back(e.amount); });
+    dispatcher.subscribe<FireDamageEvent>([&](const FireDamageEvent& e) {
+        CHECK(e.tag == 77);
+        burns.push_back(e.burnSeconds);
+    });
+    
+    dispatcher.dispatch(DamageEvent(1));
+    dispatcher.dispatch(FireDamageEvent(2, 1.5f));
+    dispatcher.dispatch(InfernoEvent(3, 10));
+    
+    CHECK((amounts == std::vector<int>{1, 2, 3}));
+    CHECK((burns == std::vector<float>{1.5f, 2.5f}));
+    
+    // The deferred queue copies the derived event and converts on dispatch
+    dispatcher.enqueue(InfernoEvent(4, 20));
+    CHECK(dispatcher.process_queued_events() == 1);
+    CHECK((amounts == std::vector<int>{1, 2, 3, 4}));
+}
+
+// Inherited listeners interleave with the derived type's own by priority
+void test_inherited_priority_order() {
+    EventCore::EventDispatcher dispatcher;
+    std::vector<int> order;
+    
+    dispatcher.subscribe<FireDamageEvent>([&](const FireDamageEvent&) { order.push_back(3); },
+                                          EventCore::EventPriority::Low);
+    dispatcher.subscribe<DamageEvent>([&](const DamageEvent&) { order.push_back(1); },
+                                      EventCore::EventPriority::Critical);
+    dispatcher.subscribe<InfernoEvent>([&](const InfernoEvent&) { order.push_back(2); });
+    
+    dispatcher.dispatch(InfernoEvent(5, 1));
+    CHECK((order == std::vector<int>{1, 2, 3}));
+}
+
+// Base listeners that come and go are added to and tombstoned in the derived lists in place
+void test_base_listener_churn() {
+    EventCore::EventDispatcher dispatcher;
+    std::vector<int> order;
+    std::vector<EventCore::SubscriptionHandle> handles;
+    
+    auto own = dispatcher.subscribe<InfernoEvent>([&](const InfernoEvent&) { order.push_back(-1); });
+    for (int i = 0; i < 64; ++i) {
+        handles.push_back(dispatcher.subscribe<DamageEvent>([&order, i](const DamageEvent&) { order.push_back(i); }));
+    }
+    auto batch = std::make_shared<BatchRecorder>(order);
+    dispatcher.subscribe_batch<DamageEvent>(batch, &BatchRecorder::on_damage);
+    for (int i = 0; i < 64; i += 2) {
+        CHECK(dispatcher.unsubscribe(handles[i]));
+    }
+    handles.push_back(dispatcher.subscribe<FireDamageEvent>([&](const FireDamageEvent&) { order.push_back(64); }));
+    
+    dispatcher.dispatch(InfernoEvent(1, 1));
+    std::vector<int> expected{-1};
+    for (int i = 1; i < 64; i += 2) {
+        expected.push_back(i);
+    }
+    expected.push_back(64);
+    CHECK(order == expected);
+    
+    // Removing a base listener that was appended late, from every depth
+    order.clear();
+    CHECK(dispatcher.unsubscribe(handles.back()));
+    CHECK(dispatcher.unsubscribe(handles[1]));
+    dispatcher.dispatch(FireDamageEvent(2, 1.0f));
+    CHECK(order.size() == 31);
+    CHECK(order.front() == 3);
+    
+    order.clear();
+    CHECK(dispatcher.unsubscribe(own));
+    dispatcher.dispatch(InfernoEvent(3, 1));
+    CHECK(order.size() == 31);
+    CHECK(order.front() == 3);
+    CHECK(dispatcher.get_total_listener_count() == 32);
+}
+
+} // namespace
+
+int main() {
+    test_base_subobject_conversion();
+    test_inherited_priority_order();
+    test_base_listener_churn();
+    
+    return EventCore::test::report("event hierarchy");
+}
@@ -0,0 +1,110 @@
+// Keyed subscriptions of EventDispatcher: priority order against the
+// unkeyed listeners of the same type and key index churn.
+
+#include "EventCore/EventDispatcher.hpp"
+#include "TestSupport.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace {
+
+struct EntityMovedEvent : public EventCore::Event {
+    std::uint64_t entity = 0;
+    
+    EntityMovedEvent() = default;
+    explicit EntityMovedEvent(std::uint64_t id) : entity(id) {}
+    
+    std::uint64_t event_key() const { return entity; }
+};
+
+// dispatch_batch() keeps a Critical keyed listener ahead of a Low unkeyed one
+void test_dispatch_batch_priority_order() {
+    EventCore::EventDispatcher dispatcher;
+    std::vector<int> order;
+    
+    auto low = dispatcher.subscribe<EntityMovedEvent>([&](const EntityMovedEvent&) {
+        order.push_back(2);
+    }, EventCore::EventPriority::Low);
+    auto critical = dispatcher.subscribe<EntityMovedEvent>(7, [&](const EntityMovedEvent&) {
+        order.push_back(1);
+    }, EventCore::EventPriority::Critical);
+    
+    const std::vector<EntityMovedEvent> events{EntityMovedEvent(7), EntityMovedEvent(8), EntityMovedEvent(7)};
+    dispatcher.dispatch_batch(std::span<const EntityMovedEvent>(events));
+    CHECK((order == std::vector<int>{1, 2, 2, 1, 2}));
+    
+    order.clear();
+    dispatcher.dispatch(EntityMovedEvent(7));
+    CHECK((order == std::vector<int>{1, 2}));
+    
+    dispatcher.unsubscribe(low);
+    dispatcher.unsubscribe(critical);
+}
+
+// Many keys come and go without disturbing the others; each change is O(1)
+void test_keyed_subscribe_unsubscribe_churn() {
+    static constexpr std::uint64_t kKeys = 32768;
+    
+    EventCore::EventDispatcher dispatcher;
+    std::vector<std::uint64_t> hits(kKeys, 0);
+    std::vector<EventCore::SubscriptionHandle> handles;
+    handles.reserve(kKeys);
+    
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t key = 0; key < kKeys; ++key) {
+        // Strided keys would pile onto a few probe chains without a mixing hash
+        handles.push_back(dispatcher.subscribe<EntityMovedEvent>(key * 1024, [&hits, key](const EntityMovedEvent&) {
+            ++hits[key];
+        }));
+    }
+    CHECK(dispatcher.get_total_listener_count() == kKeys);
+    CHECK(dispatcher.get_listener_count<EntityMovedEvent>(5 * 1024) == 1);
+    
+    // Drop the odd keys, then cycle fresh keys through the tombstones they leave
+    for (std::uint64_t key = 1; key < kKeys; key += 2) {
+        CHECK(dispatcher.unsubscribe(handles[key]));
+    }
+    for (int round = 0; round < 4; ++round) {
+        for (std::uint64_t key = 1; key < kKeys; key += 2) {
+            handles[key] = dispatcher.subscribe<EntityMovedEvent>((kKeys + key) * 1024, [&hits, key](const EntityMovedEvent&) {
+                ++hits[key];
+            });
+        }
+        for (std::uint64_t key = 1; key < kKeys; key += 2) {
+            CHECK(dispatcher.unsubscribe(handles[key]));
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    
+    CHECK(dispatcher.get_total_listener_count() == kKeys / 2);
+    CHECK(dispatcher.get_listener_count<EntityMovedEvent>(1024) == 0);
+    CHECK(dispatcher.get_listener_count<EntityMovedEvent>((kKeys + 1) * 1024) == 0);
+    CHECK(dispatcher.get_listener_count<EntityMovedEvent>(2 * 1024) == 1);
+    
+    dispatcher.dispatch(EntityMovedEvent(2 * 1024));
+    dispatcher.dispatch(EntityMovedEvent(3 * 1024));
+    dispatcher.dispatch(EntityMovedEvent((kKeys + 3) * 1024));
+    CHECK(hits[2] == 1);
+    CHECK(hits[3] == 0);
+    
+    // Copying the key index per change made this quadratic (minutes); linear is well under this
+    CHECK(elapsed < std::chrono::seconds(20));
+    
+    for (std::uint64_t key = 0; key < kKeys; key += 2) {
+        CHECK(dispatcher.unsubscribe(handles[key]));
+    }
+    CHECK(dispatcher.get_total_listener_count() == 0);
+    CHECK(dispatcher.get_event_type_count() == 0);
+}
+
+} // namespace
+
+int main() {
+    test_dispatch_batch_priority_order();
+    test_keyed_subscribe_unsubscribe_churn();
+    
+    return EventCore::test::report("keyed dispatch");
+}
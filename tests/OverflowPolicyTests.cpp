@@ -0,0 +1,259 @@
+// Behaviour of bounded deferred queues (QueuePolicy) and of coalescing
+// placeholders under each OverflowPolicy.
+
+#include "EventCore/EventDispatcher.hpp"
+#include "TestSupport.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct PositionEvent : public EventCore::Event {
+    static constexpr bool event_coalescing = true;
+    std::uint32_t entityId = 0;
+    int value = 0;
+    
+    PositionEvent() = default;
+    PositionEvent(std::uint32_t id, int v) : entityId(id), value(v) {}
+    
+    std::uint64_t event_key() const { return entityId; }
+};
+
+struct PlainEvent : public EventCore::Event {
+    int value = 0;
+    
+    PlainEvent() = default;
+    explicit PlainEvent(int v) : value(v) {}
+};
+
+// Keyed but not coalescing: only OverflowPolicy::Coalesce merges it
+struct SampleEvent : public EventCore::Event {
+    std::uint32_t channel = 0;
+    int value = 0;
+    
+    SampleEvent() = default;
+    SampleEvent(std::uint32_t c, int v) : channel(c), value(v) {}
+    
+    std::uint64_t event_key() const { return channel; }
+};
+
+EventCore::DispatcherConfig bounded(std::size_t capacity, EventCore::OverflowPolicy overflow) {
+    EventCore::DispatcherConfig config;
+    config.queue = EventCore::QueuePolicy::bounded(capacity, overflow);
+    return config;
+}
+
+/**
+ * @brief Records what reached the listeners of both event types
+ */
+struct Received {
+    std::vector<int> positions;
+    std::vector<int> plain;
+    std::vector<int> samples;
+    
+    explicit Received(EventCore::EventDispatcher& dispatcher) {
+        dispatcher.subscribe<PositionEvent>([this](const PositionEvent& event) { positions.push_back(event.value); });
+        dispatcher.subscribe<PlainEvent>([this](const PlainEvent& event) { plain.push_back(event.value); });
+        dispatcher.subscribe<SampleEvent>([this](const SampleEvent& event) { samples.push_back(event.value); });
+    }
+};
+
+// A full queue blocks producers of new keys until the consumer makes room,
+// while events for an already queued key coalesce without needing a slot
+void test_block_with_coalescing_event() {
+    EventCore::EventDispatcher dispatcher(bounded(2, EventCore::OverflowPolicy::Block));
+    Received received(dispatcher);
+    
+    CHECK(dispatcher.enqueue(PositionEvent(1, 1)));
+    CHECK(dispatcher.enqueue(PositionEvent(2, 2)));
+    CHECK(dispatcher.enqueue(PositionEvent(1, 10)));        // Full, but key 1 is pending
+    CHECK(dispatcher.get_coalesced_event_count() == 1);
+    
+    std::atomic<bool> enqueued{false};
+    std::thread producer([&] {
+        dispatcher.enqueue(PositionEvent(3, 3));
+        enqueued.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(!enqueued.load());
+    
+    std::size_t processed = 0;
+    while (!enqueued.load() || processed < 3) {
+        processed += dispatcher.process_queued_events();
+        std::this_thread::yield();
+    }
+    producer.join();
+    
+    CHECK(processed == 3);
+    CHECK((received.positions == std::vector<int>{10, 2, 3}));
+    CHECK(dispatcher.get_dropped_event_count() == 0);
+}
+
+// Listeners that enqueue while their thread drains a full Block queue are
+// admitted over capacity instead of waiting for themselves
+void test_block_reentrant_enqueue() {
+    EventCore::EventDispatcher dispatcher(bounded(1, EventCore::OverflowPolicy::Block));
+    Received received(dispatcher);
+    dispatcher.subscribe<PlainEvent>([&dispatcher](const PlainEvent& event) {
+        if (event.value < 3) {
+            dispatcher.enqueue(PlainEvent(event.value + 1));
+            dispatcher.enqueue(PositionEvent(static_cast<std::uint32_t>(event.value), event.value));
+        }
+    });
+    
+    CHECK(dispatcher.enqueue(PlainEvent(1)));
+    std::size_t processed = 0;
+    for (int pass = 0; pass < 4; ++pass) {
+        processed += dispatcher.process_queued_events();
+    }
+    CHECK(processed == 5);
+    CHECK((received.plain == std::vector<int>{1, 2, 3}));
+    CHECK((received.positions == std::vector<int>{1, 2}));
+}
+
+// A refused placeholder takes its stored value back, so the key is not
+// stuck coalescing into a value nothing will drain
+void test_drop_newest_with_coalescing_event() {
+    EventCore::EventDispatcher dispatcher(bounded(1, EventCore::OverflowPolicy::DropNewest));
+    Received received(dispatcher);
+    
+    CHECK(dispatcher.enqueue(PositionEvent(1, 1)));
+    CHECK(!dispatcher.enqueue(PositionEvent(2, 2)));        // Full: a new key is rejected
+    CHECK(dispatcher.enqueue(PositionEvent(1, 10)));        // A pending key still coalesces
+    CHECK(!dispatcher.enqueue(PlainEvent(1)));
+    CHECK(dispatcher.get_dropped_event_count() == 2);
+    CHECK(dispatcher.get_coalesced_event_count() == 1);
+    
+    CHECK(dispatcher.process_queued_events() == 1);
+    CHECK((received.positions == std::vector<int>{10}));
+    
+    CHECK(dispatcher.enqueue(PositionEvent(2, 20)));
+    CHECK(dispatcher.process_queued_events() == 1);
+    CHECK((received.positions == std::vector<int>{10, 20}));
+    CHECK(received.plain.empty());
+}
+
+// DropOldest makes room by discarding the queue head
+void test_drop_oldest_evicts_head() {
+    EventCore::EventDispatcher dispatcher(bounded(2, EventCore::OverflowPolicy::DropOldest));
+    Received received(dispatcher);
+    
+    CHECK(dispatcher.enqueue(PlainEvent(1)));
+    CHECK(dispatcher.enqueue(PlainEvent(2)));
+    CHECK(dispatcher.enqueue(PlainEvent(3)));
+    CHECK(dispatcher.enqueue(PositionEvent(4, 4)));
+    CHECK(dispatcher.get_dropped_event_count() == 2);
+    
+    CHECK(dispatcher.process_queued_events() == 2);
+    CHECK((received.plain == std::vector<int>{3}));
+    CHECK((received.positions == std::vector<int>{4}));
+}
+
+// An evicted placeholder must take its key's pending value along, or later
+// events with that key coalesce into a value nothing will ever drain
+void test_drop_oldest_evicts_placeholder_value() {
+    EventCore::EventDispatcher dispatcher(bounded(1, EventCore::OverflowPolicy::DropOldest));
+    Received received(dispatcher);
+    
+    CHECK(dispatcher.enqueue(PositionEvent(7, 1)));
+    CHECK(dispatcher.enqueue(PlainEvent(1)));           // Evicts the placeholder of key 7
+    CHECK(dispatcher.process_queued_events() == 1);
+    CHECK(received.positions.empty());
+    CHECK(received.plain == std::vector<int>{1});
+    CHECK(dispatcher.get_dropped_event_count() == 1);
+    
+    for (int round = 0; round < 5; ++round) {
+        CHECK(dispatcher.enqueue(PositionEvent(7, 10 + round)));
+        CHECK(dispatcher.process_queued_events() == 1);
+    }
+    CHECK((received.positions == std::vector<int>{10, 11, 12, 13, 14}));
+    CHECK(dispatcher.get_coalesced_event_count() == 0);
+}
+
+// Overflowed keys drain after the queue in first-arrival order, each with its
+// newest value, including keys replaced or added while a drain is part way
+// through the overflow table
+void test_coalesce_overflow_table_order() {
+    EventCore::EventDispatcher dispatcher(bounded(1, EventCore::OverflowPolicy::Coalesce));
+    Received received(dispatcher);
+    
+    CHECK(dispatcher.enqueue(SampleEvent(0, 0)));
+    for (std::uint32_t channel = 1; channel <= 200; ++channel) {
+        CHECK(dispatcher.enqueue(SampleEvent(channel, static_cast<int>(channel))));
+    }
+    CHECK(dispatcher.enqueue(SampleEvent(150, 1150)));
+    CHECK(dispatcher.get_coalesced_event_count() == 1);
+    
+    CHECK(dispatcher.process_queued_events(100) == 100);
+    CHECK(received.samples.size() == 100);
+    CHECK(received.samples.front() == 0 && received.samples.back() == 99);
+    
+    CHECK(dispatcher.enqueue(SampleEvent(999, 999)));      // Fills the queue again
+    CHECK(dispatcher.enqueue(SampleEvent(150, 2150)));     // Still pending: replaced in place
+    CHECK(dispatcher.enqueue(SampleEvent(10, 10010)));     // Already drained: a new entry at the back
+    CHECK(dispatcher.process_queued_events() == 103);
+    
+    std::vector<int> expected;
+    for (int channel = 0; channel < 100; ++channel) {
+        expected.push_back(channel);
+    }
+    expected.push_back(999);
+    for (int channel = 100; channel <= 200; ++channel) {
+        expected.push_back(channel == 150 ? 2150 : channel);
+    }
+    expected.push_back(10010);
+    CHECK(received.samples == expected);
+    
+    // Taking the larger part of the table compacts it; later replacements must still find their entry
+    received.samples.clear();
+    CHECK(dispatcher.enqueue(SampleEvent(0, 0)));
+    for (std::uint32_t channel = 1; channel <= 10; ++channel) {
+        CHECK(dispatcher.enqueue(SampleEvent(channel, static_cast<int>(channel))));
+    }
+    CHECK(dispatcher.process_queued_events(7) == 7);
+    CHECK(dispatcher.enqueue(SampleEvent(99, 99)));
+    CHECK(dispatcher.enqueue(SampleEvent(9, 909)));
+    CHECK(dispatcher.process_queued_events() == 5);
+    CHECK((received.samples == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 99, 7, 8, 909, 10}));
+}
+
+// A coalescing placeholder that overflows waits in the overflow table and
+// still resolves to its key's newest value
+void test_coalesce_with_coalescing_event() {
+    EventCore::EventDispatcher dispatcher(bounded(1, EventCore::OverflowPolicy::Coalesce));
+    Received received(dispatcher);
+    
+    CHECK(dispatcher.enqueue(PositionEvent(1, 1)));
+    CHECK(dispatcher.enqueue(PositionEvent(2, 2)));         // Placeholder overflows
+    CHECK(dispatcher.enqueue(PositionEvent(2, 20)));        // Coalesced into the pending value
+    CHECK(dispatcher.enqueue(PositionEvent(1, 10)));
+    CHECK(!dispatcher.enqueue(PlainEvent(1)));              // Unkeyed events are rejected
+    CHECK(dispatcher.get_coalesced_event_count() == 2);
+    CHECK(dispatcher.get_dropped_event_count() == 1);
+    
+    CHECK(dispatcher.process_queued_events() == 2);
+    CHECK((received.positions == std::vector<int>{10, 20}));
+    CHECK(received.plain.empty());
+    
+    CHECK(dispatcher.enqueue(PositionEvent(2, 200)));
+    CHECK(dispatcher.process_queued_events() == 1);
+    CHECK((received.positions == std::vector<int>{10, 20, 200}));
+}
+
+} // namespace
+
+int main() {
+    test_block_with_coalescing_event();
+    test_block_reentrant_enqueue();
+    test_drop_newest_with_coalescing_event();
+    test_drop_oldest_evicts_head();
+    test_drop_oldest_evicts_placeholder_value();
+    test_coalesce_overflow_table_order();
+    test_coalesce_with_coalescing_event();
+    
+    return EventCore::test::report("overflow policy");
+}
@@ -0,0 +1,166 @@
+// Subscription bookkeeping of StaticEventDispatcher: targeted unsubscribe,
+// changes made from inside a dispatch and expired-listener cleanup.
+
+#include "EventCore/StaticEventDispatcher.hpp"
+#include "TestSupport.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct TickEvent : public EventCore::Event {
+    int frame = 0;
+    
+    TickEvent() = default;
+    explicit TickEvent(int f) : frame(f) {}
+};
+
+struct InputEvent : public EventCore::Event {
+    int key = 0;
+};
+
+using Dispatcher = EventCore::StaticEventDispatcher<TickEvent, InputEvent>;
+
+struct TwoHandlers {
+    int first = 0;
+    int second = 0;
+    
+    void on_first(const TickEvent&) { ++first; }
+    void on_second(const TickEvent&) { ++second; }
+};
+
+/**
+ * @brief Runs an action from inside its handler, once
+ */
+struct Reentrant {
+    std::function<void()> action;
+    
+    void on_tick(const TickEvent&) {
+        if (auto pending = std::move(action)) {
+            action = nullptr;
+            pending();
+        }
+    }
+};
+
+bool totals_consistent(const Dispatcher& dispatcher) {
+    return dispatcher.get_total_listener_count() ==
+           dispatcher.get_listener_count<TickEvent>() + dispatcher.get_listener_count<InputEvent>();
+}
+
+// Unsubscribing one member function leaves the instance's other handlers in place
+void test_unsubscribe_removes_only_that_member() {
+    Dispatcher dispatcher;
+    TwoHandlers listener;
+    dispatcher.subscribe_unowned<TickEvent>(&listener, &TwoHandlers::on_first);
+    dispatcher.subscribe_unowned<TickEvent>(&listener, &TwoHandlers::on_second);
+    
+    dispatcher.unsubscribe<TickEvent>(&listener, &TwoHandlers::on_first);
+    dispatcher.dispatch(TickEvent(1));
+    CHECK(listener.first == 0);
+    CHECK(listener.second == 1);
+    CHECK(dispatcher.get_listener_count<TickEvent>() == 1);
+    CHECK(totals_consistent(dispatcher));
+}
+
+// Compile-time bound handlers are removed through the matching template form
+void test_unsubscribe_compile_time_bound() {
+    Dispatcher dispatcher;
+    TwoHandlers listener;
+    dispatcher.subscribe_unowned<&TwoHandlers::on_first>(&listener);
+    dispatcher.subscribe_unowned<&TwoHandlers::on_second>(&listener);
+    
+    dispatcher.unsubscribe<&TwoHandlers::on_second>(&listener);
+    dispatcher.dispatch(TickEvent(1));
+    CHECK(listener.first == 1);
+    CHECK(listener.second == 0);
+    CHECK(dispatcher.get_total_listener_count() == 1);
+}
+
+// A subscription made and removed inside a dispatch never reaches the list,
+// and the total count follows it both ways
+void test_subscribe_and_unsubscribe_inside_dispatch() {
+    Dispatcher dispatcher;
+    TwoHandlers listener;
+    Reentrant trigger;
+    trigger.action = [&] {
+        dispatcher.subscribe_unowned<TickEvent>(&listener, &TwoHandlers::on_first);
+        dispatcher.subscribe_unowned<TickEvent>(&listener, &TwoHandlers::on_second);
+        CHECK(dispatcher.get_total_listener_count() == 3);
+        dispatcher.unsubscribe<TickEvent>(&listener, &TwoHandlers::on_first);
+        CHECK(dispatcher.get_total_listener_count() == 2);
+    };
+    dispatcher.subscribe_unowned<TickEvent>(&trigger, &Reentrant::on_tick);
+    
+    dispatcher.dispatch(TickEvent(1));
+    CHECK(dispatcher.get_listener_count<TickEvent>() == 2);
+    CHECK(totals_consistent(dispatcher));
+    
+    dispatcher.dispatch(TickEvent(2));
+    CHECK(listener.first == 0);
+    CHECK(listener.second == 1);
+}
+
+// Expired owned listeners are cleaned up whether or not they are inserted yet
+void test_cleanup_expired_listeners_includes_pending() {
+    Dispatcher dispatcher;
+    auto inserted = std::make_shared<TwoHandlers>();
+    auto pending = std::make_shared<TwoHandlers>();
+    dispatcher.subscribe<TickEvent>(inserted, &TwoHandlers::on_first);
+    
+    Reentrant trigger;
+    trigger.action = [&] {
+        dispatcher.subscribe<TickEvent>(pending, &TwoHandlers::on_first);
+        pending.reset();
+        inserted.reset();
+        CHECK(dispatcher.cleanup_expired_listeners() == 2);
+        CHECK(dispatcher.get_total_listener_count() == 1);
+    };
+    dispatcher.subscribe_unowned<TickEvent>(&trigger, &Reentrant::on_tick);
+    
+    dispatcher.dispatch(TickEvent(1));
+    CHECK(dispatcher.get_listener_count<TickEvent>() == 1);
+    CHECK(totals_consistent(dispatcher));
+}
+
+// Higher priorities run first, and a consuming handler stops the rest
+void test_priority_order_and_consume() {
+    Dispatcher dispatcher;
+    std::vector<int> order;
+    struct Recorder {
+        std::vector<int>* order;
+        int id;
+        bool consume;
+        EventCore::EventResult on_tick(const TickEvent&) {
+            order->push_back(id);
+            return consume ? EventCore::EventResult::Consumed : EventCore::EventResult::Continue;
+        }
+    };
+    Recorder low{&order, 1, false};
+    Recorder high{&order, 2, true};
+    Recorder normal{&order, 3, false};
+    dispatcher.subscribe_unowned<TickEvent>(&low, &Recorder::on_tick, EventCore::EventPriority::Low);
+    dispatcher.subscribe_unowned<TickEvent>(&normal, &Recorder::on_tick);
+    
+    CHECK(dispatcher.dispatch(TickEvent(1)) == EventCore::EventResult::Continue);
+    CHECK((order == std::vector<int>{3, 1}));
+    
+    dispatcher.subscribe_unowned<TickEvent>(&high, &Recorder::on_tick, EventCore::EventPriority::High);
+    order.clear();
+    CHECK(dispatcher.dispatch(TickEvent(2)) == EventCore::EventResult::Consumed);
+    CHECK((order == std::vector<int>{2}));
+}
+
+} // namespace
+
+int main() {
+    test_unsubscribe_removes_only_that_member();
+    test_unsubscribe_compile_time_bound();
+    test_subscribe_and_unsubscribe_inside_dispatch();
+    test_cleanup_expired_listeners_includes_pending();
+    test_priority_order_and_consume();
+    
+    return EventCore::test::report("StaticEventDispatcher");
+}
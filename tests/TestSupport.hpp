@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdio>
+
+namespace EventCore {
+namespace test {
+
+/**
+ * @brief Number of failed CHECKs so far in this test executable
+ */
+inline int& failure_count() {
+    static int failures = 0;
+    return failures;
+}
+
+/**
+ * @brief Print the outcome of a test executable and return its exit code
+ */
+inline int report(const char* suiteName) {
+    if (failure_count() != 0) {
+        std::printf("%s: %d check(s) failed\n", suiteName, failure_count());
+        return 1;
+    }
+    std::printf("All %s tests passed\n", suiteName);
+    return 0;
+}
+
+} // namespace test
+} // namespace EventCore
+
+// Records a failure and carries on, so one run reports every broken check
+#define CHECK(condition)                                                                \
+    do {                                                                                \
+        if (!(condition)) {                                                             \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);   \
+            ++EventCore::test::failure_count();                                         \
+        }                                                                               \
+    } while (false)